@@ -6,8 +6,11 @@
  * @author Mysvac
  * @note Contains macro definitions only, no main function included
  * @details Provides comprehensive testing macros for unit testing including:
- *          - Test case registration and organization
+ *          - Test case, fixture, parameterized, typed test and benchmark registration and organization
  *          - Assertion and expectation macros
+ *          - Expression-decomposing checks (M_CHECK, M_REQUIRE)
+ *          - Allocation count checks with optional counting allocation hooks
+ *          - Performance checks against time budgets (M_EXPECT_FASTER_THAN, M_EXPECT_FASTER)
  *          - Exception testing capabilities
  *          - Floating-point comparisons with tolerance
  *          - String comparisons with case-insensitive options
@@ -23,26 +26,305 @@
 //////////////////////////////////////////////////////////////////////////
 //// Test Case Declaration
 
+#if defined(VCT_TEST_UNIT_SECTION_REGISTRATION)
+
+#if !defined(__ELF__) || !(defined(__GNUC__) || defined(__clang__))
+#error "VCT_TEST_UNIT_SECTION_REGISTRATION requires GCC or Clang targeting ELF"
+#endif
+
+#if __has_attribute(retain)
+#define _M_VCT_TEST_SECTION_ATTRIBUTES gnu::used, gnu::retain, gnu::section("vct_test_unit")
+#else
+#define _M_VCT_TEST_SECTION_ATTRIBUTES gnu::used, gnu::section("vct_test_unit")
+#endif
+
+// Bounds of the descriptor section, provided by the linker (null if no test is registered)
+extern "C" {
+    [[gnu::weak]] extern const vct::test::unit::TestDescriptor* const __start_vct_test_unit[];
+    [[gnu::weak]] extern const vct::test::unit::TestDescriptor* const __stop_vct_test_unit[];
+}
+
+// Hands the section bounds to the runner once per program, without allocating
+inline const bool _m_vct_test_unit_section_registered =
+    (vct::test::unit::set_test_section(__start_vct_test_unit, __stop_vct_test_unit), true);
+
+/**
+ * @brief Test registration macro (linker section mode)
+ * @param test_suite The name of the test suite
+ * @param test_name The name of the test case
+ * @param ... Optional TestOptions designated initializers, e.g. `.timeout = std::chrono::seconds{ 5 }`
+ * @details Enabled by defining VCT_TEST_UNIT_SECTION_REGISTRATION before including
+ *          this header. Generates a test function, a constant-initialized
+ *          TestDescriptor and a pointer to it in the `vct_test_unit` section,
+ *          which start() walks at run time. No code runs and nothing is
+ *          allocated per test before main().
+ *          Usage: M_TEST(SuiteName, TestName) { test code here }
+ */
+#define M_TEST(test_suite, test_name, ...) \
+    void test_unit_##test_suite##_##test_name(); \
+    constinit const vct::test::unit::TestDescriptor test_descriptor_##test_suite##_##test_name{ \
+            #test_suite, \
+            #test_name, \
+            &test_unit_##test_suite##_##test_name, \
+            vct::test::unit::TestOptions{ __VA_ARGS__ } \
+        }; \
+    [[_M_VCT_TEST_SECTION_ATTRIBUTES]] constinit const vct::test::unit::TestDescriptor* const \
+        test_descriptor_ptr_##test_suite##_##test_name = &test_descriptor_##test_suite##_##test_name; \
+    void test_unit_##test_suite##_##test_name()
+
+/**
+ * @brief Fixture test registration macro (linker section mode)
+ * @param test_fixture A class derived from vct::test::unit::Test, also used as suite name
+ * @param test_name The name of the test case
+ * @param ... Optional TestOptions designated initializers
+ * @details Like M_TEST, but the body is a member function of a class derived
+ *          from `test_fixture`, run between its SetUp() and TearDown(). The
+ *          fixture's SetUpTestSuite()/TearDownTestSuite() run once around the suite.
+ *          Usage: M_TEST_F(FixtureName, TestName) { test code using fixture members }
+ */
+#define M_TEST_F(test_fixture, test_name, ...) \
+    class TestFixture_##test_fixture##_##test_name final : public test_fixture { \
+            void TestBody() override; \
+        public: \
+            static constexpr vct::test::unit::SuiteHooks suite_hooks() noexcept { \
+                return { &test_fixture::SetUpTestSuite, &test_fixture::TearDownTestSuite }; \
+            } \
+        }; \
+    void test_unit_##test_fixture##_##test_name() { \
+        TestFixture_##test_fixture##_##test_name test; \
+        test.run(); \
+    } \
+    constinit const vct::test::unit::TestDescriptor test_descriptor_##test_fixture##_##test_name{ \
+            #test_fixture, \
+            #test_name, \
+            &test_unit_##test_fixture##_##test_name, \
+            vct::test::unit::TestOptions{ __VA_ARGS__ }, \
+            TestFixture_##test_fixture##_##test_name::suite_hooks() \
+        }; \
+    [[_M_VCT_TEST_SECTION_ATTRIBUTES]] constinit const vct::test::unit::TestDescriptor* const \
+        test_descriptor_ptr_##test_fixture##_##test_name = &test_descriptor_##test_fixture##_##test_name; \
+    void TestFixture_##test_fixture##_##test_name::TestBody()
+
+/**
+ * @brief Value-parameterized test registration macro (linker section mode)
+ * @param test_suite The name of the test suite
+ * @param test_name The name of the test case
+ * @param params Expression yielding the parameters, a range or a std::generator
+ * @param ... Optional TestOptions designated initializers
+ * @details Like M_TEST, but the body runs once per parameter, available as
+ *          `param`. See the registry mode variant below.
+ *          Usage: M_TEST_P(SuiteName, TestName, std::views::iota(0, 100)) { test code using param }
+ */
+#define M_TEST_P(test_suite, test_name, params, ...) \
+    static auto test_params_##test_suite##_##test_name() { return params; } \
+    void test_unit_##test_suite##_##test_name( \
+        [[maybe_unused]] const std::ranges::range_value_t<decltype(test_params_##test_suite##_##test_name())>& param); \
+    constinit const vct::test::unit::TestDescriptor test_descriptor_##test_suite##_##test_name{ \
+            #test_suite, \
+            #test_name, \
+            nullptr, \
+            vct::test::unit::TestOptions{ __VA_ARGS__ }, \
+            {}, \
+            &vct::test::unit::run_params<&test_params_##test_suite##_##test_name, &test_unit_##test_suite##_##test_name> \
+        }; \
+    [[_M_VCT_TEST_SECTION_ATTRIBUTES]] constinit const vct::test::unit::TestDescriptor* const \
+        test_descriptor_ptr_##test_suite##_##test_name = &test_descriptor_##test_suite##_##test_name; \
+    void test_unit_##test_suite##_##test_name( \
+        [[maybe_unused]] const std::ranges::range_value_t<decltype(test_params_##test_suite##_##test_name())>& param)
+
+/**
+ * @brief Typed test registration macro (linker section mode)
+ * @param test_suite The name of the test suite
+ * @param test_name The name of the test case
+ * @param ... A vct::test::unit::Types<...> list of the types to test
+ * @details Like M_TEST, but the body is a template instantiated for each
+ *          type, available as `TypeParam`. The descriptors of all instances
+ *          are built at compile time and placed in the section together; the
+ *          explicit alignment keeps the compiler from padding the array.
+ *          Usage: M_TYPED_TEST(SuiteName, TestName, vct::test::unit::Types<int, std::string>) { test code using TypeParam }
+ */
+#define M_TYPED_TEST(test_suite, test_name, ...) \
+    template<typename TypeParam> \
+    struct TypedTest_##test_suite##_##test_name { \
+            static constexpr std::string_view suite{ #test_suite }; \
+            static constexpr std::string_view name{ #test_name }; \
+            static void run(); \
+        }; \
+    [[_M_VCT_TEST_SECTION_ATTRIBUTES]] alignas(const vct::test::unit::TestDescriptor*) constinit const \
+        decltype(vct::test::unit::TypedTestDescriptors<TypedTest_##test_suite##_##test_name, __VA_ARGS__>::pointers) \
+        test_descriptor_ptrs_##test_suite##_##test_name = \
+            vct::test::unit::TypedTestDescriptors<TypedTest_##test_suite##_##test_name, __VA_ARGS__>::pointers; \
+    template<typename TypeParam> \
+    void TypedTest_##test_suite##_##test_name<TypeParam>::run()
+
+#else
+
 /**
  * @brief Test registration macro
  * @param test_suite The name of the test suite
  * @param test_name The name of the test case
+ * @param ... Optional TestOptions designated initializers, e.g. `.timeout = std::chrono::seconds{ 5 }`
  * @details This macro automatically generates a test function and registers it
  *          to the global singleton through static variable initialization.
+ *          Define VCT_TEST_UNIT_SECTION_REGISTRATION before including this
+ *          header to register through a linker section instead.
  *          Usage: M_TEST(SuiteName, TestName) { test code here }
+ *                 M_TEST(SuiteName, TestName, .timeout = std::chrono::seconds{ 5 }) { test code here }
  */
-#define M_TEST(test_suite, test_name) \
+#define M_TEST(test_suite, test_name, ...) \
     void test_unit_##test_suite##_##test_name(); \
     struct TestRegistrar_##test_suite##_##test_name { \
             TestRegistrar_##test_suite##_##test_name() { \
                 vct::test::unit::get_test_registry()[#test_suite].push_back({ \
                     #test_name, \
-                    &test_unit_##test_suite##_##test_name \
+                    &test_unit_##test_suite##_##test_name, \
+                    vct::test::unit::TestOptions{ __VA_ARGS__ } \
                 }); \
             } \
         } test_registrar_##test_suite##_##test_name; \
     void test_unit_##test_suite##_##test_name()
 
+/**
+ * @brief Fixture test registration macro
+ * @param test_fixture A class derived from vct::test::unit::Test, also used as suite name
+ * @param test_name The name of the test case
+ * @param ... Optional TestOptions designated initializers
+ * @details Like M_TEST, but the body is a member function of a class derived
+ *          from `test_fixture`, so it can use the fixture's protected members.
+ *          Each test runs on a fresh fixture instance between SetUp() and
+ *          TearDown(). The fixture's static SetUpTestSuite() and
+ *          TearDownTestSuite() run once before the first and after the last
+ *          test of the suite.
+ *          Usage: M_TEST_F(FixtureName, TestName) { test code using fixture members }
+ */
+#define M_TEST_F(test_fixture, test_name, ...) \
+    class TestFixture_##test_fixture##_##test_name final : public test_fixture { \
+            void TestBody() override; \
+        public: \
+            static constexpr vct::test::unit::SuiteHooks suite_hooks() noexcept { \
+                return { &test_fixture::SetUpTestSuite, &test_fixture::TearDownTestSuite }; \
+            } \
+        }; \
+    void test_unit_##test_fixture##_##test_name() { \
+        TestFixture_##test_fixture##_##test_name test; \
+        test.run(); \
+    } \
+    struct TestRegistrar_##test_fixture##_##test_name { \
+            TestRegistrar_##test_fixture##_##test_name() { \
+                vct::test::unit::get_test_registry()[#test_fixture].push_back({ \
+                    #test_name, \
+                    &test_unit_##test_fixture##_##test_name, \
+                    vct::test::unit::TestOptions{ __VA_ARGS__ }, \
+                    TestFixture_##test_fixture##_##test_name::suite_hooks() \
+                }); \
+            } \
+        } test_registrar_##test_fixture##_##test_name; \
+    void TestFixture_##test_fixture##_##test_name::TestBody()
+
+/**
+ * @brief Value-parameterized test registration macro
+ * @param test_suite The name of the test suite
+ * @param test_name The name of the test case
+ * @param params Expression yielding the parameters, a range or a std::generator
+ * @param ... Optional TestOptions designated initializers, applied to every instance
+ * @details Like M_TEST, but the body runs once per parameter, available as
+ *          `param`, and each run is reported as `SuiteName.TestName/index`.
+ *          The expression is evaluated when the test starts and its elements
+ *          are pulled one at a time as the runner reaches them, so large
+ *          sweeps are neither materialized nor registered per parameter.
+ *          Parameter expressions containing top-level commas must be parenthesized.
+ *          Usage: M_TEST_P(SuiteName, TestName, std::views::iota(0, 100)) { test code using param }
+ *                 M_TEST_P(SuiteName, TestName, shapes()) { ... }  // std::generator<Shape> shapes();
+ *                 M_TEST_P(SuiteName, TestName, (std::array{ 1, 2, 3 }), .timeout = std::chrono::seconds{ 5 }) { ... }
+ */
+#define M_TEST_P(test_suite, test_name, params, ...) \
+    static auto test_params_##test_suite##_##test_name() { return params; } \
+    void test_unit_##test_suite##_##test_name( \
+        [[maybe_unused]] const std::ranges::range_value_t<decltype(test_params_##test_suite##_##test_name())>& param); \
+    struct TestRegistrar_##test_suite##_##test_name { \
+            TestRegistrar_##test_suite##_##test_name() { \
+                vct::test::unit::get_test_registry()[#test_suite].push_back({ \
+                    #test_name, \
+                    {}, \
+                    vct::test::unit::TestOptions{ __VA_ARGS__ }, \
+                    {}, \
+                    &vct::test::unit::run_params<&test_params_##test_suite##_##test_name, &test_unit_##test_suite##_##test_name> \
+                }); \
+            } \
+        } test_registrar_##test_suite##_##test_name; \
+    void test_unit_##test_suite##_##test_name( \
+        [[maybe_unused]] const std::ranges::range_value_t<decltype(test_params_##test_suite##_##test_name())>& param)
+
+/**
+ * @brief Typed test registration macro
+ * @param test_suite The name of the test suite
+ * @param test_name The name of the test case
+ * @param ... A vct::test::unit::Types<...> list of the types to test
+ * @details Like M_TEST, but the body is a template instantiated at compile
+ *          time for each type of the list, available as `TypeParam`. One
+ *          test case per type is registered, named after the type, e.g.
+ *          `SuiteName.TestName<int>`.
+ *          Usage: M_TYPED_TEST(SuiteName, TestName, vct::test::unit::Types<int, std::string>) { test code using TypeParam }
+ */
+#define M_TYPED_TEST(test_suite, test_name, ...) \
+    template<typename TypeParam> \
+    struct TypedTest_##test_suite##_##test_name { \
+            static constexpr std::string_view suite{ #test_suite }; \
+            static constexpr std::string_view name{ #test_name }; \
+            static void run(); \
+        }; \
+    struct TestRegistrar_##test_suite##_##test_name { \
+            TestRegistrar_##test_suite##_##test_name() { \
+                vct::test::unit::register_typed_test<TypedTest_##test_suite##_##test_name>(__VA_ARGS__{}); \
+            } \
+        } test_registrar_##test_suite##_##test_name; \
+    template<typename TypeParam> \
+    void TypedTest_##test_suite##_##test_name<TypeParam>::run()
+
+#endif
+
+/**
+ * @brief Mark a test suite as not parallel-safe
+ * @param test_suite The name of the test suite
+ * @details When tests are run with `--jobs=N`, the cases of this suite are not
+ *          distributed over the worker pool. They are executed one at a time
+ *          after all parallel-safe suites have finished.
+ *          Usage: M_TEST_SUITE_SERIAL(SuiteName);
+ */
+#define M_TEST_SUITE_SERIAL(test_suite) \
+    struct SerialSuiteRegistrar_##test_suite { \
+            SerialSuiteRegistrar_##test_suite() { \
+                vct::test::unit::get_serial_suites().insert(#test_suite); \
+            } \
+        } serial_suite_registrar_##test_suite
+
+/**
+ * @brief Benchmark registration macro
+ * @param bench_suite The name of the benchmark suite
+ * @param bench_name The name of the benchmark
+ * @param ... Optional BenchmarkOptions designated initializers
+ * @details Generates a benchmark function taking `vct::test::unit::BenchmarkState& state`
+ *          and registers it to the global benchmark registry. The body must loop
+ *          over `state` exactly once; only that loop is timed. Benchmarks are
+ *          executed by start() in `--benchmark` mode. With `.max_threads`, the
+ *          body runs concurrently on a range of thread counts, see
+ *          `state.thread_index()` and `state.threads()`.
+ *          Usage: M_BENCHMARK(SuiteName, BenchName) { for (auto _ : state) { code } }
+ *          Usage: M_BENCHMARK(Queue, Push, .max_threads = 8, .pin_threads = true) { ... }
+ */
+#define M_BENCHMARK(bench_suite, bench_name, ...) \
+    void bench_unit_##bench_suite##_##bench_name(vct::test::unit::BenchmarkState& state); \
+    struct BenchmarkRegistrar_##bench_suite##_##bench_name { \
+            BenchmarkRegistrar_##bench_suite##_##bench_name() { \
+                vct::test::unit::get_benchmark_registry()[#bench_suite].push_back({ \
+                    #bench_name, \
+                    &bench_unit_##bench_suite##_##bench_name, \
+                    vct::test::unit::BenchmarkOptions{ __VA_ARGS__ } \
+                }); \
+            } \
+        } bench_registrar_##bench_suite##_##bench_name; \
+    void bench_unit_##bench_suite##_##bench_name([[maybe_unused]] vct::test::unit::BenchmarkState& state)
+
 
 
 
@@ -66,10 +348,10 @@
 
 /**
  * @brief Add a failure record but continue execution
- * @details Throws ExpectException, recording failure but not terminating test function
+ * @details Records a failure for the current test without throwing, execution continues
  */
 #define M_EXPECT_FAIL( msg ) \
-    throw vct::test::unit::ExpectException( "Expect fail, msg: " #msg )
+    vct::test::unit::add_failure( "Expect fail, msg: " #msg )
 
 
 
@@ -87,7 +369,7 @@
         try{    \
             __VA_ARGS__;    \
         }catch(...){    \
-            throw vct::test::unit::ExpectException( #__VA_ARGS__ " thrown exception"); \
+            vct::test::unit::add_failure( #__VA_ARGS__ " thrown exception"); \
         }    \
     }while(false)
 
@@ -103,7 +385,7 @@
         }catch(...){    \
             break;    \
         }    \
-        throw vct::test::unit::ExpectException( #__VA_ARGS__ " no exception thrown"); \
+        vct::test::unit::add_failure( #__VA_ARGS__ " no exception thrown"); \
     }while(false)
 
 /**
@@ -120,9 +402,10 @@
         }catch(const Exception&){    \
             break;    \
         }catch(...){    \
-            throw vct::test::unit::ExpectException( #statement " exception thrown but not match"); \
+            vct::test::unit::add_failure( #statement " exception thrown but not match"); \
+            break;    \
         }    \
-        throw vct::test::unit::ExpectException( #statement " no exception thrown"); \
+        vct::test::unit::add_failure( #statement " no exception thrown"); \
     }while(false)
 
 
@@ -188,12 +471,14 @@
  */
 #define M_EXPECT_TRUE(condition) \
     do{    \
+        std::string _m_vct_failure;    \
         try{    \
             if(condition) break;   \
-            else throw vct::test::unit::ExpectException( #condition " return false"); \
+            else _m_vct_failure = #condition " return false"; \
         }catch(const std::exception& e){    \
-            throw vct::test::unit::ExpectException(e.what());    \
+            _m_vct_failure = e.what();    \
         }    \
+        vct::test::unit::add_failure(std::move(_m_vct_failure));    \
     }while(false)
 
 /**
@@ -203,12 +488,14 @@
  */
 #define M_EXPECT_FALSE(condition) \
     do{    \
+        std::string _m_vct_failure;    \
         try{    \
-            if(condition) throw vct::test::unit::ExpectException( #condition " return true"); \
+            if(condition) _m_vct_failure = #condition " return true"; \
             else break; \
         }catch(const std::exception& e){    \
-            throw vct::test::unit::ExpectException(e.what());    \
+            _m_vct_failure = e.what();    \
         }    \
+        vct::test::unit::add_failure(std::move(_m_vct_failure));    \
     }while(false)
 
 /**
@@ -256,12 +543,14 @@
  */
 #define M_EXPECT_EQ(val1, val2) \
     do{    \
+        std::string _m_vct_failure;    \
         try{    \
             if(val1 == val2) break;   \
-            else throw vct::test::unit::ExpectException( #val1 " != " #val2 ); \
+            else _m_vct_failure = #val1 " != " #val2; \
         }catch(const std::exception& e){    \
-            throw vct::test::unit::ExpectException(e.what());    \
+            _m_vct_failure = e.what();    \
         }    \
+        vct::test::unit::add_failure(std::move(_m_vct_failure));    \
     }while(false)
 
 /**
@@ -272,12 +561,14 @@
  */
 #define M_EXPECT_NE(val1, val2) \
     do{    \
+        std::string _m_vct_failure;    \
         try{    \
             if(val1 != val2) break;   \
-            else throw vct::test::unit::ExpectException( #val1 " == " #val2 ); \
+            else _m_vct_failure = #val1 " == " #val2; \
         }catch(const std::exception& e){    \
-            throw vct::test::unit::ExpectException(e.what());    \
+            _m_vct_failure = e.what();    \
         }    \
+        vct::test::unit::add_failure(std::move(_m_vct_failure));    \
     }while(false)
 
 /**
@@ -288,12 +579,14 @@
  */
 #define M_EXPECT_LT(val1, val2) \
     do{    \
+        std::string _m_vct_failure;    \
         try{    \
             if(val1 < val2) break;   \
-            else throw vct::test::unit::ExpectException( #val1 " >= " #val2 ); \
+            else _m_vct_failure = #val1 " >= " #val2; \
         }catch(const std::exception& e){    \
-            throw vct::test::unit::ExpectException(e.what());    \
+            _m_vct_failure = e.what();    \
         }    \
+        vct::test::unit::add_failure(std::move(_m_vct_failure));    \
     }while(false)
 
 /**
@@ -304,12 +597,14 @@
  */
 #define M_EXPECT_LE(val1, val2) \
     do{    \
+        std::string _m_vct_failure;    \
         try{    \
             if(val1 <= val2) break;   \
-            else throw vct::test::unit::ExpectException( #val1 " > " #val2 ); \
+            else _m_vct_failure = #val1 " > " #val2; \
         }catch(const std::exception& e){    \
-            throw vct::test::unit::ExpectException(e.what());    \
+            _m_vct_failure = e.what();    \
         }    \
+        vct::test::unit::add_failure(std::move(_m_vct_failure));    \
     }while(false)
 
 /**
@@ -320,12 +615,14 @@
  */
 #define M_EXPECT_GT(val1, val2) \
     do{    \
+        std::string _m_vct_failure;    \
         try{    \
             if(val1 > val2) break;   \
-            else throw vct::test::unit::ExpectException( #val1 " <= " # val2 ); \
+            else _m_vct_failure = #val1 " <= " # val2; \
         }catch(const std::exception& e){    \
-            throw vct::test::unit::ExpectException(e.what());    \
+            _m_vct_failure = e.what();    \
         }    \
+        vct::test::unit::add_failure(std::move(_m_vct_failure));    \
     }while(false)
 
 /**
@@ -336,12 +633,14 @@
  */
 #define M_EXPECT_GE(val1, val2) \
     do{    \
+        std::string _m_vct_failure;    \
         try{    \
             if(val1 >= val2) break;   \
-            else throw vct::test::unit::ExpectException( #val1 " < " # val2 ); \
+            else _m_vct_failure = #val1 " < " # val2; \
         }catch(const std::exception& e){    \
-            throw vct::test::unit::ExpectException(e.what());    \
+            _m_vct_failure = e.what();    \
         }    \
+        vct::test::unit::add_failure(std::move(_m_vct_failure));    \
     }while(false)
 
 /**
@@ -452,13 +751,17 @@
  */
 #define M_EXPECT_DOUBLE_EQ_DEFAULT(val1, val2) \
     do{    \
+        std::string _m_vct_failure;    \
         try{    \
+            const auto _m_vct_val1 = (val1); \
+            const auto _m_vct_val2 = (val2); \
             constexpr double epsilon = 4 * std::numeric_limits<double>::epsilon(); \
-            if(std::abs(val1 - val2) <= epsilon * std::max(std::abs(val1), std::abs(val2))) break;   \
-            else throw vct::test::unit::ExpectException("Expected: " #val1 " == " #val2 "\nActual: " + std::to_string(val1) + " vs " + std::to_string(val2)); \
+            if(std::abs(_m_vct_val1 - _m_vct_val2) <= epsilon * std::max(std::abs(_m_vct_val1), std::abs(_m_vct_val2))) break;   \
+            else _m_vct_failure = "Expected: " #val1 " == " #val2 "\nActual: " + std::to_string(_m_vct_val1) + " vs " + std::to_string(_m_vct_val2); \
         }catch(const std::exception& e){    \
-            throw vct::test::unit::ExpectException(e.what());    \
+            _m_vct_failure = e.what();    \
         }    \
+        vct::test::unit::add_failure(std::move(_m_vct_failure));    \
     }while(false)
 
 /**
@@ -469,13 +772,17 @@
  */
 #define M_EXPECT_FLOAT_EQ_DEFAULT(val1, val2) \
     do{    \
+        std::string _m_vct_failure;    \
         try{    \
+            const auto _m_vct_val1 = (val1); \
+            const auto _m_vct_val2 = (val2); \
             constexpr float epsilon = 4 * std::numeric_limits<float>::epsilon(); \
-            if(std::abs(val1 - val2) <= epsilon * std::max(std::abs(val1), std::abs(val2))) break;   \
-            else throw vct::test::unit::ExpectException("Expected: " #val1 " == " #val2 "\nActual: " + std::to_string(val1) + " vs " + std::to_string(val2)); \
+            if(std::abs(_m_vct_val1 - _m_vct_val2) <= epsilon * std::max(std::abs(_m_vct_val1), std::abs(_m_vct_val2))) break;   \
+            else _m_vct_failure = "Expected: " #val1 " == " #val2 "\nActual: " + std::to_string(_m_vct_val1) + " vs " + std::to_string(_m_vct_val2); \
         }catch(const std::exception& e){    \
-            throw vct::test::unit::ExpectException(e.what());    \
+            _m_vct_failure = e.what();    \
         }    \
+        vct::test::unit::add_failure(std::move(_m_vct_failure));    \
     }while(false)
 
 /**
@@ -488,12 +795,16 @@
  */
 #define M_EXPECT_FLOAT_EQ(val1, val2, dv) \
     do{    \
+        std::string _m_vct_failure;    \
         try{    \
-            if(std::abs(val1 - val2) <= dv) break;   \
-            else throw vct::test::unit::ExpectException( "std::abs( " #val1 " - " # val2 " ) > " #dv ); \
+            const auto _m_vct_val1 = (val1); \
+            const auto _m_vct_val2 = (val2); \
+            if(std::abs(_m_vct_val1 - _m_vct_val2) <= dv) break;   \
+            else _m_vct_failure = "std::abs( " #val1 " - " # val2 " ) > " #dv; \
         }catch(const std::exception& e){    \
-            throw vct::test::unit::ExpectException(e.what());    \
+            _m_vct_failure = e.what();    \
         }    \
+        vct::test::unit::add_failure(std::move(_m_vct_failure));    \
     }while(false)
 
 /**
@@ -506,12 +817,16 @@
  */
 #define M_EXPECT_FLOAT_NE(val1, val2, dv) \
     do{    \
+        std::string _m_vct_failure;    \
         try{    \
-            if(std::abs(val1 - val2) > dv) break;   \
-            else throw vct::test::unit::ExpectException( "std::abs( " #val1 " - " # val2 " ) <= " #dv ); \
+            const auto _m_vct_val1 = (val1); \
+            const auto _m_vct_val2 = (val2); \
+            if(std::abs(_m_vct_val1 - _m_vct_val2) > dv) break;   \
+            else _m_vct_failure = "std::abs( " #val1 " - " # val2 " ) <= " #dv; \
         }catch(const std::exception& e){    \
-            throw vct::test::unit::ExpectException(e.what());    \
+            _m_vct_failure = e.what();    \
         }    \
+        vct::test::unit::add_failure(std::move(_m_vct_failure));    \
     }while(false)
 
 /**
@@ -523,9 +838,11 @@
 #define M_ASSERT_DOUBLE_EQ_DEFAULT(val1, val2) \
     do{    \
         try{    \
+            const auto _m_vct_val1 = (val1); \
+            const auto _m_vct_val2 = (val2); \
             constexpr double epsilon = 4 * std::numeric_limits<double>::epsilon(); \
-            if(std::abs(val1 - val2) <= epsilon * std::max(std::abs(val1), std::abs(val2))) break;   \
-            else throw vct::test::unit::AssertException("Expected: " #val1 " == " #val2 "\nActual: " + std::to_string(val1) + " vs " + std::to_string(val2)); \
+            if(std::abs(_m_vct_val1 - _m_vct_val2) <= epsilon * std::max(std::abs(_m_vct_val1), std::abs(_m_vct_val2))) break;   \
+            else throw vct::test::unit::AssertException("Expected: " #val1 " == " #val2 "\nActual: " + std::to_string(_m_vct_val1) + " vs " + std::to_string(_m_vct_val2)); \
         }catch(const std::exception& e){    \
             throw vct::test::unit::AssertException(e.what());    \
         }    \
@@ -540,9 +857,11 @@
 #define M_ASSERT_FLOAT_EQ_DEFAULT(val1, val2) \
     do{    \
         try{    \
+            const auto _m_vct_val1 = (val1); \
+            const auto _m_vct_val2 = (val2); \
             constexpr float epsilon = 4 * std::numeric_limits<float>::epsilon(); \
-            if(std::abs(val1 - val2) <= epsilon * std::max(std::abs(val1), std::abs(val2))) break;   \
-            else throw vct::test::unit::AssertException("Expected: " #val1 " == " #val2 "\nActual: " + std::to_string(val1) + " vs " + std::to_string(val2)); \
+            if(std::abs(_m_vct_val1 - _m_vct_val2) <= epsilon * std::max(std::abs(_m_vct_val1), std::abs(_m_vct_val2))) break;   \
+            else throw vct::test::unit::AssertException("Expected: " #val1 " == " #val2 "\nActual: " + std::to_string(_m_vct_val1) + " vs " + std::to_string(_m_vct_val2)); \
         }catch(const std::exception& e){    \
             throw vct::test::unit::AssertException(e.what());    \
         }    \
@@ -559,7 +878,9 @@
 #define M_ASSERT_FLOAT_EQ(val1, val2, dv) \
     do{    \
         try{    \
-            if(std::abs(val1 - val2) <= dv) break;   \
+            const auto _m_vct_val1 = (val1); \
+            const auto _m_vct_val2 = (val2); \
+            if(std::abs(_m_vct_val1 - _m_vct_val2) <= dv) break;   \
             else throw vct::test::unit::AssertException( "std::abs( " #val1 " - " # val2 " ) > " #dv ); \
         }catch(const std::exception& e){    \
             throw vct::test::unit::AssertException(e.what());    \
@@ -577,7 +898,9 @@
 #define M_ASSERT_FLOAT_NE(val1, val2, dv) \
     do{    \
         try{    \
-            if(std::abs(val1 - val2) > dv) break;   \
+            const auto _m_vct_val1 = (val1); \
+            const auto _m_vct_val2 = (val2); \
+            if(std::abs(_m_vct_val1 - _m_vct_val2) > dv) break;   \
             else throw vct::test::unit::AssertException( "std::abs( " #val1 " - " # val2 " ) <= " #dv ); \
         }catch(const std::exception& e){    \
             throw vct::test::unit::AssertException(e.what());    \
@@ -587,6 +910,65 @@
 
 
 
+//////////////////////////////////////////////////////////////////////////
+//// Expression Decomposition Macros
+
+// `Decomposer{} <= a == b` relies on operator precedence on purpose
+#if defined(__GNUC__)
+#define _M_VCT_DECOMPOSE_WARNINGS_OFF \
+    _Pragma("GCC diagnostic push") \
+    _Pragma("GCC diagnostic ignored \"-Wparentheses\"")
+#define _M_VCT_DECOMPOSE_WARNINGS_ON _Pragma("GCC diagnostic pop")
+#else
+#define _M_VCT_DECOMPOSE_WARNINGS_OFF
+#define _M_VCT_DECOMPOSE_WARNINGS_ON
+#endif
+
+/**
+ * @brief Expect an expression to be true, printing its operands on failure
+ * @param ... A comparison such as `a == b`, `a < b` or `a >= b`, or a single value
+ * @details Each operand is evaluated exactly once. When the check fails, the
+ *          operand values are formatted with std::formatter ("{?}" for types
+ *          without one); nothing is formatted when it passes. Combine
+ *          conditions with separate checks, `a && b` is rejected.
+ *          Test fails but continues if the expression is false.
+ *          Usage: M_CHECK(queue.size() == expected_size);
+ */
+#define M_CHECK(...) \
+    do{    \
+        _M_VCT_DECOMPOSE_WARNINGS_OFF \
+        std::string _m_vct_failure;    \
+        try{    \
+            auto failure = vct::test::unit::check_expression(vct::test::unit::Decomposer{} <= __VA_ARGS__, #__VA_ARGS__); \
+            if(!failure) break;   \
+            else _m_vct_failure = std::move(*failure); \
+        }catch(const std::exception& e){    \
+            _m_vct_failure = e.what();    \
+        }    \
+        vct::test::unit::add_failure(std::move(_m_vct_failure));    \
+        _M_VCT_DECOMPOSE_WARNINGS_ON \
+    }while(false)
+
+/**
+ * @brief Assert an expression to be true, printing its operands on failure
+ * @param ... A comparison such as `a == b`, `a < b` or `a >= b`, or a single value
+ * @details Like M_CHECK, but the test fails and terminates if the expression is false.
+ */
+#define M_REQUIRE(...) \
+    do{    \
+        _M_VCT_DECOMPOSE_WARNINGS_OFF \
+        try{    \
+            auto failure = vct::test::unit::check_expression(vct::test::unit::Decomposer{} <= __VA_ARGS__, #__VA_ARGS__); \
+            if(!failure) break;   \
+            else throw vct::test::unit::AssertException(std::move(*failure)); \
+        }catch(const std::exception& e){    \
+            throw vct::test::unit::AssertException(e.what());    \
+        }    \
+        _M_VCT_DECOMPOSE_WARNINGS_ON \
+    }while(false)
+
+
+
 //////////////////////////////////////////////////////////////////////////
 //// String Comparison Macros
 
@@ -595,86 +977,90 @@
  * @brief Expect two strings to be equal
  * @param str1 The first string
  * @param str2 The second string
- * @details Converts parameters to std::string and compares, test fails but continues if not equal
+ * @details Compares through std::string_view without copying, test fails but continues if not equal
  */
 #define M_EXPECT_STREQ(str1, str2) \
     do{    \
+        std::string _m_vct_failure;    \
         try{    \
-            std::string s1(str1), s2(str2); \
-            if(s1 == s2) break;   \
-            else throw vct::test::unit::ExpectException("Expected: " #str1 " == " #str2 "\nActual: \"" + s1 + "\" vs \"" + s2 + "\""); \
+            auto failure = vct::test::unit::compare_strings(str1, str2, vct::test::unit::StringComparison::Equal, #str1, #str2); \
+            if(!failure) break;   \
+            else _m_vct_failure = std::move(*failure); \
         }catch(const std::exception& e){    \
-            throw vct::test::unit::ExpectException(e.what());    \
+            _m_vct_failure = e.what();    \
         }    \
+        vct::test::unit::add_failure(std::move(_m_vct_failure));    \
     }while(false)
 
 /**
  * @brief Expect two strings to be not equal
  * @param str1 The first string
  * @param str2 The second string
- * @details Converts parameters to std::string and compares, test fails but continues if equal
+ * @details Compares through std::string_view without copying, test fails but continues if equal
  */
 #define M_EXPECT_STRNE(str1, str2) \
     do{    \
+        std::string _m_vct_failure;    \
         try{    \
-            std::string s1(str1), s2(str2); \
-            if(s1 != s2) break;   \
-            else throw vct::test::unit::ExpectException("Expected: " #str1 " != " #str2 "\nActual: both are \"" + s1 + "\""); \
+            auto failure = vct::test::unit::compare_strings(str1, str2, vct::test::unit::StringComparison::NotEqual, #str1, #str2); \
+            if(!failure) break;   \
+            else _m_vct_failure = std::move(*failure); \
         }catch(const std::exception& e){    \
-            throw vct::test::unit::ExpectException(e.what());    \
+            _m_vct_failure = e.what();    \
         }    \
+        vct::test::unit::add_failure(std::move(_m_vct_failure));    \
     }while(false)
 
 /**
  * @brief Expect two strings to be equal (case-insensitive)
  * @param str1 The first string
  * @param str2 The second string
- * @details Converts both strings to lowercase and compares, test fails but continues if not equal
+ * @details Compares ASCII letters case-insensitively through std::string_view without copying, test fails but continues if not equal
  */
 #define M_EXPECT_STRCASEEQ(str1, str2) \
     do{    \
+        std::string _m_vct_failure;    \
         try{    \
-            std::string s1(str1), s2(str2); \
-            std::transform(s1.begin(), s1.end(), s1.begin(), [](unsigned char c){ return std::tolower(c); }); \
-            std::transform(s2.begin(), s2.end(), s2.begin(), [](unsigned char c){ return std::tolower(c); }); \
-            if(s1 == s2) break;   \
-            else throw vct::test::unit::ExpectException("Expected: " #str1 " == " #str2 " (ignoring case)\nActual: \"" + std::string(str1) + "\" vs \"" + std::string(str2) + "\""); \
+            auto failure = vct::test::unit::compare_strings(str1, str2, vct::test::unit::StringComparison::EqualIgnoringCase, #str1, #str2); \
+            if(!failure) break;   \
+            else _m_vct_failure = std::move(*failure); \
         }catch(const std::exception& e){    \
-            throw vct::test::unit::ExpectException(e.what());    \
+            _m_vct_failure = e.what();    \
         }    \
+        vct::test::unit::add_failure(std::move(_m_vct_failure));    \
     }while(false)
 
 /**
  * @brief Expect two strings to be not equal (case-insensitive)
  * @param str1 The first string
  * @param str2 The second string
- * @details Converts both strings to lowercase and compares, test fails but continues if equal
+ * @details Compares ASCII letters case-insensitively through std::string_view without copying, test fails but continues if equal
  */
 #define M_EXPECT_STRCASENE(str1, str2) \
     do{    \
+        std::string _m_vct_failure;    \
         try{    \
-            std::string s1(str1), s2(str2); \
-            std::transform(s1.begin(), s1.end(), s1.begin(), [](unsigned char c){ return std::tolower(c); }); \
-            std::transform(s2.begin(), s2.end(), s2.begin(), [](unsigned char c){ return std::tolower(c); }); \
-            if(s1 != s2) break;   \
-            else throw vct::test::unit::ExpectException("Expected: " #str1 " != " #str2 " (ignoring case)\nActual: both are \"" + std::string(str1) + "\""); \
+            auto failure = vct::test::unit::compare_strings(str1, str2, vct::test::unit::StringComparison::NotEqualIgnoringCase, #str1, #str2); \
+            if(!failure) break;   \
+            else _m_vct_failure = std::move(*failure); \
         }catch(const std::exception& e){    \
-            throw vct::test::unit::ExpectException(e.what());    \
+            _m_vct_failure = e.what();    \
         }    \
+        vct::test::unit::add_failure(std::move(_m_vct_failure));    \
     }while(false)
 
 /**
  * @brief Assert two strings to be equal
  * @param str1 The first string
  * @param str2 The second string
- * @details Converts parameters to std::string and compares, test fails and terminates if not equal
+ * @details Compares through std::string_view without copying, test fails and terminates if not equal
  */
 #define M_ASSERT_STREQ(str1, str2) \
     do{    \
         try{    \
-            std::string s1(str1), s2(str2); \
-            if(s1 == s2) break;   \
-            else throw vct::test::unit::AssertException("Expected: " #str1 " == " #str2 "\nActual: \"" + s1 + "\" vs \"" + s2 + "\""); \
+            auto failure = vct::test::unit::compare_strings(str1, str2, vct::test::unit::StringComparison::Equal, #str1, #str2); \
+            if(!failure) break;   \
+            else throw vct::test::unit::AssertException(std::move(*failure)); \
         }catch(const std::exception& e){    \
             throw vct::test::unit::AssertException(e.what());    \
         }    \
@@ -684,14 +1070,14 @@
  * @brief Assert two strings to be not equal
  * @param str1 The first string
  * @param str2 The second string
- * @details Converts parameters to std::string and compares, test fails and terminates if equal
+ * @details Compares through std::string_view without copying, test fails and terminates if equal
  */
 #define M_ASSERT_STRNE(str1, str2) \
     do{    \
         try{    \
-            std::string s1(str1), s2(str2); \
-            if(s1 != s2) break;   \
-            else throw vct::test::unit::AssertException("Expected: " #str1 " != " #str2 "\nActual: both are \"" + s1 + "\""); \
+            auto failure = vct::test::unit::compare_strings(str1, str2, vct::test::unit::StringComparison::NotEqual, #str1, #str2); \
+            if(!failure) break;   \
+            else throw vct::test::unit::AssertException(std::move(*failure)); \
         }catch(const std::exception& e){    \
             throw vct::test::unit::AssertException(e.what());    \
         }    \
@@ -701,16 +1087,14 @@
  * @brief Assert two strings to be equal (case-insensitive)
  * @param str1 The first string
  * @param str2 The second string
- * @details Converts both strings to lowercase and compares, test fails and terminates if not equal
+ * @details Compares ASCII letters case-insensitively through std::string_view without copying, test fails and terminates if not equal
  */
 #define M_ASSERT_STRCASEEQ(str1, str2) \
     do{    \
         try{    \
-            std::string s1(str1), s2(str2); \
-            std::transform(s1.begin(), s1.end(), s1.begin(), [](unsigned char c){ return std::tolower(c); }); \
-            std::transform(s2.begin(), s2.end(), s2.begin(), [](unsigned char c){ return std::tolower(c); }); \
-            if(s1 == s2) break;   \
-            else throw vct::test::unit::AssertException("Expected: " #str1 " == " #str2 " (ignoring case)\nActual: \"" + std::string(str1) + "\" vs \"" + std::string(str2) + "\""); \
+            auto failure = vct::test::unit::compare_strings(str1, str2, vct::test::unit::StringComparison::EqualIgnoringCase, #str1, #str2); \
+            if(!failure) break;   \
+            else throw vct::test::unit::AssertException(std::move(*failure)); \
         }catch(const std::exception& e){    \
             throw vct::test::unit::AssertException(e.what());    \
         }    \
@@ -720,16 +1104,14 @@
  * @brief Assert two strings to be not equal (case-insensitive)
  * @param str1 The first string
  * @param str2 The second string
- * @details Converts both strings to lowercase and compares, test fails and terminates if equal
+ * @details Compares ASCII letters case-insensitively through std::string_view without copying, test fails and terminates if equal
  */
 #define M_ASSERT_STRCASENE(str1, str2) \
     do{    \
         try{    \
-            std::string s1(str1), s2(str2); \
-            std::transform(s1.begin(), s1.end(), s1.begin(), [](unsigned char c){ return std::tolower(c); }); \
-            std::transform(s2.begin(), s2.end(), s2.begin(), [](unsigned char c){ return std::tolower(c); }); \
-            if(s1 != s2) break;   \
-            else throw vct::test::unit::AssertException("Expected: " #str1 " != " #str2 " (ignoring case)\nActual: both are \"" + std::string(str1) + "\""); \
+            auto failure = vct::test::unit::compare_strings(str1, str2, vct::test::unit::StringComparison::NotEqualIgnoringCase, #str1, #str2); \
+            if(!failure) break;   \
+            else throw vct::test::unit::AssertException(std::move(*failure)); \
         }catch(const std::exception& e){    \
             throw vct::test::unit::AssertException(e.what());    \
         }    \
@@ -748,12 +1130,14 @@
  */
 #define M_EXPECT_PRED1(pred, val1) \
     do{    \
+        std::string _m_vct_failure;    \
         try{    \
             if(pred(val1)) break;   \
-            else throw vct::test::unit::ExpectException(#pred "(" #val1 ") failed"); \
+            else _m_vct_failure = #pred "(" #val1 ") failed"; \
         }catch(const std::exception& e){    \
-            throw vct::test::unit::ExpectException(e.what());    \
+            _m_vct_failure = e.what();    \
         }    \
+        vct::test::unit::add_failure(std::move(_m_vct_failure));    \
     }while(false)
 
 /**
@@ -765,12 +1149,14 @@
  */
 #define M_EXPECT_PRED2(pred, val1, val2) \
     do{    \
+        std::string _m_vct_failure;    \
         try{    \
             if(pred(val1, val2)) break;   \
-            else throw vct::test::unit::ExpectException(#pred "(" #val1 ", " #val2 ") failed"); \
+            else _m_vct_failure = #pred "(" #val1 ", " #val2 ") failed"; \
         }catch(const std::exception& e){    \
-            throw vct::test::unit::ExpectException(e.what());    \
+            _m_vct_failure = e.what();    \
         }    \
+        vct::test::unit::add_failure(std::move(_m_vct_failure));    \
     }while(false)
 
 /**
@@ -806,6 +1192,209 @@
         }    \
     }while(false)
 
+//////////////////////////////////////////////////////////////////////////
+//// Performance Assertion Macros
+
+
+/**
+ * @brief Wrap a statement into a callable running it a given number of times
+ * @details Internal helper of the performance assertion macros.
+ */
+#define _M_VCT_REPEATED_STATEMENT(...) \
+    [&](const std::size_t _m_vct_runs) { \
+        for (std::size_t _m_vct_run = 0; _m_vct_run < _m_vct_runs; ++_m_vct_run) { __VA_ARGS__; } \
+        vct::test::unit::ClobberMemory(); \
+    }
+
+/**
+ * @brief Expect a statement to run within a time budget
+ * @param budget A duration checked against the median, or a
+ *               vct::test::unit::TimeBudget(limit, percentile)
+ * @param ... The statement(s) to measure
+ * @details Runs the statement in calibrated batches until the confidence
+ *          interval of the percentile is tight (see TimingOptions). Results
+ *          the optimizer could discard should be passed to DoNotOptimize.
+ *          Test fails but continues if the budget is exceeded.
+ */
+#define M_EXPECT_FASTER_THAN(budget, ...) \
+    do{    \
+        std::string _m_vct_failure;    \
+        try{    \
+            auto failure = vct::test::unit::check_faster_than(budget, _M_VCT_REPEATED_STATEMENT(__VA_ARGS__), #__VA_ARGS__); \
+            if(!failure) break;   \
+            else _m_vct_failure = std::move(*failure); \
+        }catch(const std::exception& e){    \
+            _m_vct_failure = e.what();    \
+        }    \
+        vct::test::unit::add_failure(std::move(_m_vct_failure));    \
+    }while(false)
+
+/**
+ * @brief Assert a statement to run within a time budget
+ * @details See M_EXPECT_FASTER_THAN. Test fails and terminates if the budget is exceeded.
+ */
+#define M_ASSERT_FASTER_THAN(budget, ...) \
+    do{    \
+        try{    \
+            auto failure = vct::test::unit::check_faster_than(budget, _M_VCT_REPEATED_STATEMENT(__VA_ARGS__), #__VA_ARGS__); \
+            if(!failure) break;   \
+            else throw vct::test::unit::AssertException(std::move(*failure)); \
+        }catch(const std::exception& e){    \
+            throw vct::test::unit::AssertException(e.what());    \
+        }    \
+    }while(false)
+
+/**
+ * @brief Expect one statement to take at most `ratio` times the time of another
+ * @param stmt1 The statement expected to be faster
+ * @param stmt2 The reference statement
+ * @param ratio Highest allowed ratio of the median times, e.g. 0.8
+ * @details Statements containing top-level commas must be parenthesized.
+ *          Test fails but continues if the ratio is exceeded.
+ */
+#define M_EXPECT_FASTER(stmt1, stmt2, ratio) \
+    do{    \
+        std::string _m_vct_failure;    \
+        try{    \
+            auto failure = vct::test::unit::check_faster( \
+                _M_VCT_REPEATED_STATEMENT(stmt1), _M_VCT_REPEATED_STATEMENT(stmt2), ratio, #stmt1, #stmt2); \
+            if(!failure) break;   \
+            else _m_vct_failure = std::move(*failure); \
+        }catch(const std::exception& e){    \
+            _m_vct_failure = e.what();    \
+        }    \
+        vct::test::unit::add_failure(std::move(_m_vct_failure));    \
+    }while(false)
+
+/**
+ * @brief Assert one statement to take at most `ratio` times the time of another
+ * @details See M_EXPECT_FASTER. Test fails and terminates if the ratio is exceeded.
+ */
+#define M_ASSERT_FASTER(stmt1, stmt2, ratio) \
+    do{    \
+        try{    \
+            auto failure = vct::test::unit::check_faster( \
+                _M_VCT_REPEATED_STATEMENT(stmt1), _M_VCT_REPEATED_STATEMENT(stmt2), ratio, #stmt1, #stmt2); \
+            if(!failure) break;   \
+            else throw vct::test::unit::AssertException(std::move(*failure)); \
+        }catch(const std::exception& e){    \
+            throw vct::test::unit::AssertException(e.what());    \
+        }    \
+    }while(false)
+
+//////////////////////////////////////////////////////////////////////////
+//// Allocation Assertion Macros
+
+
+/**
+ * @brief Expect a statement to allocate at most a number of times on the calling thread
+ * @param max_allocs The allowed number of `operator new` calls
+ * @param ... The statement(s) to execute
+ * @details Counts the allocations made by the statement on the current thread
+ *          through the hooks enabled by VCT_TEST_UNIT_ALLOCATION_HOOKS. On
+ *          failure, reports the count, the total bytes and, with
+ *          `--allocation-stacks`, the stack of the first allocation.
+ *          Test fails but continues if the limit is exceeded.
+ */
+#define M_EXPECT_MAX_ALLOCS(max_allocs, ...) \
+    do{    \
+        std::string _m_vct_failure;    \
+        try{    \
+            vct::test::unit::AllocationScope _m_vct_allocations; \
+            __VA_ARGS__;    \
+            auto failure = _m_vct_allocations.check(max_allocs, #__VA_ARGS__); \
+            if(!failure) break;   \
+            else _m_vct_failure = std::move(*failure); \
+        }catch(const std::exception& e){    \
+            _m_vct_failure = e.what();    \
+        }    \
+        vct::test::unit::add_failure(std::move(_m_vct_failure));    \
+    }while(false)
+
+/**
+ * @brief Expect a statement not to allocate on the calling thread
+ * @param ... The statement(s) to execute
+ * @details See M_EXPECT_MAX_ALLOCS. Test fails but continues if the statement allocates.
+ */
+#define M_EXPECT_NO_ALLOC(...) M_EXPECT_MAX_ALLOCS(0, __VA_ARGS__)
+
+/**
+ * @brief Assert a statement to allocate at most a number of times on the calling thread
+ * @param max_allocs The allowed number of `operator new` calls
+ * @param ... The statement(s) to execute
+ * @details See M_EXPECT_MAX_ALLOCS. Test fails and terminates if the limit is exceeded.
+ */
+#define M_ASSERT_MAX_ALLOCS(max_allocs, ...) \
+    do{    \
+        try{    \
+            vct::test::unit::AllocationScope _m_vct_allocations; \
+            __VA_ARGS__;    \
+            auto failure = _m_vct_allocations.check(max_allocs, #__VA_ARGS__); \
+            if(!failure) break;   \
+            else throw vct::test::unit::AssertException(std::move(*failure)); \
+        }catch(const std::exception& e){    \
+            throw vct::test::unit::AssertException(e.what());    \
+        }    \
+    }while(false)
+
+/**
+ * @brief Assert a statement not to allocate on the calling thread
+ * @param ... The statement(s) to execute
+ * @details See M_EXPECT_MAX_ALLOCS. Test fails and terminates if the statement allocates.
+ */
+#define M_ASSERT_NO_ALLOC(...) M_ASSERT_MAX_ALLOCS(0, __VA_ARGS__)
+
+/*
+ * Counting allocation hooks, enabled by defining VCT_TEST_UNIT_ALLOCATION_HOOKS
+ * before including this header in exactly one translation unit of the test
+ * program. They replace the global operator new/delete; the array, nothrow
+ * and sized forms forward to these by default. Outside of an allocation
+ * check, the only added cost is a thread-local load and a branch.
+ */
+#if defined(VCT_TEST_UNIT_ALLOCATION_HOOKS)
+
+#if defined(_MSC_VER)
+#include <malloc.h>
+#endif
+
+void* operator new(std::size_t size) {
+    vct::test::unit::record_allocation(size);
+    if (void* memory = std::malloc(size != 0 ? size : 1)) return memory;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    vct::test::unit::record_allocation(size);
+    const auto align = static_cast<std::size_t>(alignment);
+#if defined(_MSC_VER)
+    if (void* memory = _aligned_malloc(size != 0 ? size : 1, align)) return memory;
+#else
+    // aligned_alloc requires a multiple of the alignment
+    if (void* memory = std::aligned_alloc(align, (std::max<std::size_t>(size, 1) + align - 1) / align * align)) return memory;
+#endif
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept {
+#if defined(_MSC_VER)
+    _aligned_free(memory);
+#else
+    std::free(memory);
+#endif
+}
+
+// Lets allocation checks report missing hooks instead of passing silently
+const bool _m_vct_test_unit_allocation_hooks_installed =
+    (vct::test::unit::set_allocation_hooks_installed(), true);
+
+#endif
+
+
+
 //////////////////////////////////////////////////////////////////////////
 
 #endif // _M_VCT_TEST_UNIT_MACROS_HPP
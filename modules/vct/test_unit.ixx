@@ -8,6 +8,45 @@
  * This module provides a comprehensive unit testing framework with GTest-style
  * output formatting and multi-suite test organization capabilities.
  */
+module;
+
+#if defined(__unix__) || defined(__APPLE__)
+#define _M_VCT_TEST_UNIT_POSIX 1
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+// Raw stack frames, captured from the stack trace signal handlers
+#if __has_include(<execinfo.h>)
+#define _M_VCT_TEST_UNIT_BACKTRACE 1
+#include <execinfo.h>
+#endif
+#endif
+
+// Performance counters of the running thread, reported with `--perf-counters`,
+// and CPU affinity of multi-threaded benchmarks
+#if defined(__linux__)
+#define _M_VCT_TEST_UNIT_PERF_EVENTS 1
+#include <linux/perf_event.h>
+#include <sched.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+// Vector instruction sets enabled for the compiler, used by the string comparisons
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define _M_VCT_TEST_UNIT_SSE2 1
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__)
+#define _M_VCT_TEST_UNIT_AVX2 1
+#include <immintrin.h>
+#endif
+
 export module vct.test.unit;
 
 import std;
@@ -20,7 +59,7 @@ import std;
  *          - Multi-suite test organization
  *          - Comprehensive assertion and expectation macros
  *          - High-precision timing measurements
- *          - Exception-based test control flow
+ *          - Non-fatal expectations and exception-based assertions
  */
 export namespace vct::test::unit{
     /**
@@ -42,10 +81,12 @@ export namespace vct::test::unit{
 
     /**
      * @class ExpectException
-     * @brief Exception thrown for expectation failures that allow test continuation
-     * @details This exception is thrown when an expectation fails (M_EXPECT_* macros).
-     *          When caught, it marks the current test case as failed but allows
-     *          execution to continue, enabling multiple failures to be reported.
+     * @brief Exception for expectation failures outside of a running test
+     * @details M_EXPECT_* macros record failures through add_failure() without
+     *          throwing. This exception is only thrown when no test is running on
+     *          the calling thread, or when user code throws it directly. When
+     *          caught by the runner, it marks the current test case as failed
+     *          and execution continues with the next test.
      * @inherits std::runtime_error
      */
     class ExpectException final : public std::runtime_error {
@@ -57,6 +98,678 @@ export namespace vct::test::unit{
         ExpectException(const std::string& msg) : std::runtime_error(msg) {}
     };
 
+    /**
+     * @struct Failure
+     * @brief A single failed expectation or assertion recorded for a test case
+     */
+    struct Failure {
+        std::string message{};          ///< Description of the failure
+        std::string file{};             ///< Source file of the failing check, empty if unknown
+        std::uint_least32_t line{};     ///< Source line of the failing check, 0 if unknown
+    };
+
+    /**
+     * @enum PerfCounter
+     * @brief Performance counters collected with `--perf-counters` (Linux only)
+     * @details The hardware counters are used where the kernel and the
+     *          virtualization allow it, the software counters otherwise.
+     */
+    enum class PerfCounter : std::uint8_t {
+        Instructions,                   ///< Retired instructions (hardware)
+        Cycles,                         ///< CPU cycles (hardware)
+        CacheMisses,                    ///< Last level cache misses (hardware)
+        BranchMisses,                   ///< Mispredicted branches (hardware)
+        TaskClock,                      ///< CPU time in nanoseconds (software)
+        PageFaults,                     ///< Page faults (software)
+        ContextSwitches                 ///< Context switches (software)
+    };
+
+    /**
+     * @brief Get the name of a performance counter as used by `perf stat`
+     * @return e.g. "instructions", "task-clock"
+     */
+    constexpr std::string_view counter_name(const PerfCounter counter) noexcept {
+        switch (counter) {
+        case PerfCounter::Instructions: return "instructions";
+        case PerfCounter::Cycles: return "cycles";
+        case PerfCounter::CacheMisses: return "cache-misses";
+        case PerfCounter::BranchMisses: return "branch-misses";
+        case PerfCounter::TaskClock: return "task-clock";
+        case PerfCounter::PageFaults: return "page-faults";
+        case PerfCounter::ContextSwitches: return "context-switches";
+        }
+        return "unknown";
+    }
+
+    /**
+     * @struct CounterValue
+     * @brief Count of one performance counter over a test or benchmark
+     */
+    struct CounterValue {
+        PerfCounter counter{};
+        std::uint64_t value{};          ///< Scaled to the full run time if the counter was multiplexed
+    };
+
+    /**
+     * @struct TestResult
+     * @brief Outcome of a single test case execution
+     */
+    struct TestResult {
+        enum class Outcome : std::uint8_t {
+            Passed,                     ///< Test function returned normally without failures
+            Assert,                     ///< AssertException was thrown
+            Expect,                     ///< Expectations failed or ExpectException was thrown
+            Unknown,                    ///< Any other std::exception was thrown
+            Crashed,                    ///< The isolated worker process died while running the test
+            Timeout                     ///< The isolated test exceeded its timeout and its worker was killed
+        };
+
+        Outcome outcome{ Outcome::Passed };
+        std::chrono::steady_clock::time_point begin{};  ///< Time the test function was entered
+        std::chrono::steady_clock::time_point end{};    ///< Time the test function returned or threw
+        std::vector<Failure> failures{};    ///< Recorded failures in order of occurrence
+        std::size_t dropped_failures{};     ///< Failures not stored because of the per-test limit
+        std::optional<std::size_t> param_index{};   ///< Parameter instance of an M_TEST_P test
+        std::vector<CounterValue> counters{};       ///< Performance counters of the test thread, with `--perf-counters`
+    };
+
+}
+
+
+/**
+ * @namespace vct::test::unit::detail
+ * @brief Test runner internals, not exported from the module
+ */
+namespace vct::test::unit::detail {
+    using clock = std::chrono::steady_clock;
+
+    /// Failures beyond this count are only counted, not stored, to bound memory in failing loops
+    constexpr std::size_t max_recorded_failures = 100;
+
+    /// Result of the test case currently running on this thread, nullptr outside of a test
+    thread_local TestResult* current_result = nullptr;
+
+    /**
+     * @brief Spelling of T as produced by the compiler
+     * @details Cut out of the signature reported by std::source_location,
+     *          e.g. "... raw_type_name() [with T = int; ...]" (GCC),
+     *          "... raw_type_name() [T = int]" (Clang) or
+     *          "... raw_type_name<int>(void)" (MSVC).
+     */
+    template<typename T>
+    consteval std::string_view raw_type_name() noexcept {
+        const std::string_view function = std::source_location::current().function_name();
+#if defined(_MSC_VER) && !defined(__clang__)
+        const auto begin = function.find("raw_type_name<") + std::string_view{ "raw_type_name<" }.size();
+        const auto end = function.rfind(">(");
+#else
+        const auto begin = function.find("T = ") + std::string_view{ "T = " }.size();
+        const auto end = std::min(function.find(';', begin), function.rfind(']'));
+#endif
+        return function.substr(begin, end - begin);
+    }
+
+    /// Parts of compiler type spellings that only add noise to test names
+#if defined(_MSC_VER) && !defined(__clang__)
+    constexpr std::array<std::string_view, 4> type_name_noise{ "__cxx11::", "__1::", "class ", "struct " };
+#else
+    constexpr std::array<std::string_view, 2> type_name_noise{ "__cxx11::", "__1::" };
+#endif
+
+    /**
+     * @brief Copy a type spelling without its noise
+     * @param text Spelling from raw_type_name()
+     * @param out Destination, or nullptr to only compute the length
+     * @return Length of the readable spelling
+     */
+    constexpr std::size_t strip_type_name(const std::string_view text, char* out) noexcept {
+        const auto is_identifier = [](const char c) {
+            return c == '_' || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+        };
+        std::size_t length = 0;
+        for (std::size_t i = 0; i < text.size();) {
+            const bool boundary = i == 0 || !is_identifier(text[i - 1]);
+            const auto noise = std::ranges::find_if(type_name_noise, [&](const std::string_view part) {
+                return boundary && text.substr(i).starts_with(part);
+            });
+            if (noise != type_name_noise.end()) {
+                i += noise->size();
+                continue;
+            }
+            if (out != nullptr) out[length] = text[i];
+            ++length;
+            ++i;
+        }
+        return length;
+    }
+
+    /// Readable spelling of T with static storage, see type_name()
+    template<typename T>
+    inline constexpr auto type_name_storage = [] {
+        constexpr auto raw = raw_type_name<T>();
+        std::array<char, strip_type_name(raw, nullptr)> text{};
+        strip_type_name(raw, text.data());
+        return text;
+    }();
+
+    /// "Name<Type>" of the instance of typed test `Test` for T, with static storage
+    template<template<typename> class Test, typename T>
+    inline constexpr auto typed_test_name_storage = [] {
+        constexpr std::string_view name = Test<T>::name;
+        constexpr auto& type = type_name_storage<T>;
+        std::array<char, name.size() + type.size() + 2> text{};
+        auto out = std::ranges::copy(name, text.begin()).out;
+        *out++ = '<';
+        out = std::ranges::copy(type, out).out;
+        *out = '>';
+        return text;
+    }();
+
+    /**
+     * @brief Format an operand of a failed M_CHECK/M_REQUIRE
+     * @return The value formatted with std::formatter, or "{?}" if T has none.
+     *         C strings are quoted, and shown as NULL like in StringOperand
+     *         rather than handed to std::format as null pointers.
+     */
+    template<typename T>
+    std::string format_operand(const T& value) {
+        if constexpr (std::is_same_v<T, const char*> || std::is_same_v<T, char*>) {
+            return value == nullptr ? std::string{ "NULL" } : std::format("\"{}\"", value);
+        } else if constexpr (std::formattable<T, char>) {
+            return std::format("{}", value);
+        } else if constexpr (std::is_pointer_v<T>) {
+            return std::format("{}", static_cast<const void*>(value));
+        } else {
+            return "{?}";
+        }
+    }
+
+    /**
+     * @struct AllocationCounter
+     * @brief Allocations counted by one AllocationScope
+     */
+    struct AllocationCounter {
+        std::size_t count{};            ///< Number of allocations
+        std::size_t bytes{};            ///< Total requested size
+        std::size_t first_size{};       ///< Size of the first allocation
+        std::string first_stack{};      ///< Stack trace of the first allocation, if captured
+        AllocationCounter* outer{};     ///< Enclosing scope on the same thread, also counting
+    };
+
+    /// Innermost AllocationScope of this thread, nullptr when none is active
+    thread_local AllocationCounter* allocation_counter = nullptr;
+
+    /// Set while the hooks capture a stack trace, whose own allocations are not counted
+    thread_local bool in_allocation_hook = false;
+
+    /// Whether the allocation hooks of the macros header are compiled into the program
+    std::atomic<bool> allocation_hooks_installed{ false };
+
+    /// Whether the first allocation of a scope records its stack trace, see RunOptions::allocation_stacks
+    std::atomic<bool> capture_allocation_stacks{ false };
+
+    /// Characters shown on each side of the first difference of long strings in failure messages
+    constexpr std::size_t string_excerpt_context = 32;
+
+    /// ASCII lower case of c, other bytes unchanged
+    constexpr char ascii_lower(const char c) noexcept {
+        return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+
+#if defined(_M_VCT_TEST_UNIT_SSE2)
+    /// ASCII lower case of 16 bytes: 'A'..'Z' get bit 0x20 set, other bytes are unchanged
+    inline __m128i ascii_lower(const __m128i bytes) noexcept {
+        const __m128i offset = _mm_sub_epi8(bytes, _mm_set1_epi8('A'));
+        const __m128i upper = _mm_cmpeq_epi8(_mm_min_epu8(offset, _mm_set1_epi8('Z' - 'A')), offset);
+        return _mm_or_si128(bytes, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+    }
+#endif
+
+#if defined(_M_VCT_TEST_UNIT_AVX2)
+    /// ASCII lower case of 32 bytes, see the SSE2 overload
+    inline __m256i ascii_lower(const __m256i bytes) noexcept {
+        const __m256i offset = _mm256_sub_epi8(bytes, _mm256_set1_epi8('A'));
+        const __m256i upper = _mm256_cmpeq_epi8(_mm256_min_epu8(offset, _mm256_set1_epi8('Z' - 'A')), offset);
+        return _mm256_or_si256(bytes, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+    }
+#endif
+
+    /**
+     * @brief Offset of the first byte at which two buffers differ, ignoring ASCII case
+     * @param s1 The first buffer
+     * @param s2 The second buffer
+     * @param length Number of bytes to compare
+     * @return The offset, `length` if the buffers are equal
+     * @details Folds and compares 32 (AVX2) or 16 (SSE2) bytes per step when
+     *          the compiler targets these instruction sets, then finishes the
+     *          tail byte by byte.
+     */
+    std::size_t ascii_case_mismatch(const char* const s1, const char* const s2, const std::size_t length) noexcept {
+        std::size_t i = 0;
+#if defined(_M_VCT_TEST_UNIT_AVX2)
+        for (; i + 32 <= length; i += 32) {
+            const __m256i a = ascii_lower(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(s1 + i)));
+            const __m256i b = ascii_lower(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(s2 + i)));
+            const auto equal = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
+            if (equal != 0xFFFF'FFFFu) return i + static_cast<std::size_t>(std::countr_one(equal));
+        }
+#endif
+#if defined(_M_VCT_TEST_UNIT_SSE2)
+        for (; i + 16 <= length; i += 16) {
+            const __m128i a = ascii_lower(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s1 + i)));
+            const __m128i b = ascii_lower(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s2 + i)));
+            const auto equal = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)));
+            if (equal != 0xFFFFu) return i + static_cast<std::size_t>(std::countr_one(equal));
+        }
+#endif
+        while (i < length && ascii_lower(s1[i]) == ascii_lower(s2[i])) ++i;
+        return i;
+    }
+
+    /**
+     * @brief Offset of the first byte at which two strings differ
+     * @param ignore_case Compare ASCII letters case-insensitively
+     * @return The offset, the length of the shorter string if one is a prefix of the other
+     */
+    std::size_t mismatch_offset(const std::string_view s1, const std::string_view s2, const bool ignore_case) noexcept {
+        const auto length = std::min(s1.size(), s2.size());
+        std::size_t i = 0;
+        if (ignore_case) {
+            i = ascii_case_mismatch(s1.data(), s2.data(), length);
+        } else {
+            // Passing checks are the common case, and memcmp is the fastest way to confirm them
+            if (s1.substr(0, length) == s2.substr(0, length)) return length;
+            while (s1[i] == s2[i]) ++i;
+        }
+        return i;
+    }
+
+    /**
+     * @brief Quote a string for a failure message, cut down to the part around `offset` if long
+     * @return The quoted text, with "..." outside the quotes where text was cut
+     */
+    std::string string_excerpt(const std::string_view text, const std::size_t offset) {
+        constexpr std::size_t window = 2 * string_excerpt_context;
+        if (text.size() <= window) return std::format("\"{}\"", text);
+        const auto first = std::min(offset > string_excerpt_context ? offset - string_excerpt_context : 0, text.size() - window);
+        return std::format("{}\"{}\"{}", first > 0 ? "..." : "", text.substr(first, window), first + window < text.size() ? "..." : "");
+    }
+
+}
+
+
+export namespace vct::test::unit {
+
+    /**
+     * @brief Record a non-fatal failure for the currently running test
+     * @param message Description of the failure
+     * @param location Source location of the failing check
+     * @details Used by the M_EXPECT_* macros. The failure is appended to the
+     *          result of the test running on the calling thread and execution
+     *          continues; start() reports all recorded failures once the test
+     *          returns. Checks must run on the thread of the test: elsewhere
+     *          there is no result to record into and this throws ExpectException
+     *          instead, which calls std::terminate when it escapes the function
+     *          of a std::thread spawned by the test.
+     */
+    void add_failure(std::string message, const std::source_location location = std::source_location::current()) {
+        auto* const result = detail::current_result;
+        if (result == nullptr) throw ExpectException(message);
+        if (result->failures.size() < detail::max_recorded_failures) {
+            result->failures.push_back({ std::move(message), location.file_name(), location.line() });
+        } else {
+            ++result->dropped_failures;
+        }
+    }
+
+    /**
+     * @struct StringOperand
+     * @brief Operand of the M_*_STR* macros, viewing a C string, std::string or std::string_view
+     * @details A null C string is kept apart from the empty string: it is
+     *          only equal to another null C string.
+     */
+    struct StringOperand {
+        StringOperand(const char* text) noexcept : text(text != nullptr ? std::string_view{ text } : std::string_view{}), null(text == nullptr) {}
+        StringOperand(const std::string_view text) noexcept : text(text) {}
+        StringOperand(const std::string& text) noexcept : text(text) {}
+
+        std::string_view text;      ///< Viewed characters, empty for a null C string
+        bool null{ false };         ///< Constructed from a null C string
+    };
+
+    /**
+     * @enum StringComparison
+     * @brief Comparison performed by compare_strings()
+     */
+    enum class StringComparison : std::uint8_t {
+        Equal,
+        NotEqual,
+        EqualIgnoringCase,          ///< ASCII letters compare case-insensitively
+        NotEqualIgnoringCase,
+    };
+
+    /**
+     * @brief Check a string comparison of the M_*_STR* macros
+     * @param s1 The first string
+     * @param s2 The second string
+     * @param comparison The expected relation
+     * @param expr1 Source text of the first operand
+     * @param expr2 Source text of the second operand
+     * @return The failure message, or std::nullopt if the comparison holds
+     * @details Compares the viewed characters in place, so a passing check
+     *          allocates nothing, and strings of different lengths without
+     *          reading them. Case-insensitive comparisons fold ASCII letters
+     *          with SSE2/AVX2 where available. Only a failure formats its
+     *          message, which quotes strings longer than 64 characters as
+     *          excerpts around their first difference and, for an expected
+     *          equality, gives the offset of that difference.
+     */
+    std::optional<std::string> compare_strings(
+        const StringOperand s1, const StringOperand s2, const StringComparison comparison,
+        const std::string_view expr1, const std::string_view expr2
+    ) {
+        const bool ignore_case = comparison == StringComparison::EqualIgnoringCase
+            || comparison == StringComparison::NotEqualIgnoringCase;
+        const bool expect_equal = comparison == StringComparison::Equal
+            || comparison == StringComparison::EqualIgnoringCase;
+
+        // Strings of different lengths are never equal, so they are not scanned
+        const bool equal = s1.null == s2.null && s1.text.size() == s2.text.size()
+            && detail::mismatch_offset(s1.text, s2.text, ignore_case) == s1.text.size();
+        if (equal == expect_equal) return std::nullopt;
+
+        // Equal strings are quoted from their start
+        const auto offset = equal ? 0 : detail::mismatch_offset(s1.text, s2.text, ignore_case);
+        const auto quote = [&](const StringOperand& s) {
+            return s.null ? std::string{ "NULL" } : detail::string_excerpt(s.text, offset);
+        };
+        const std::string_view relation = expect_equal ? "==" : "!=";
+        const std::string_view suffix = ignore_case ? " (ignoring case)" : "";
+        if (!expect_equal) {
+            return std::format("Expected: {} {} {}{}\nActual: both are {}", expr1, relation, expr2, suffix, quote(s1));
+        }
+        auto message = std::format("Expected: {} {} {}{}\nActual: {} vs {}", expr1, relation, expr2, suffix, quote(s1), quote(s2));
+        // A null C string has no characters to point into
+        if (!s1.null && !s2.null) {
+            std::format_to(std::back_inserter(message), "\nFirst difference at offset {} (sizes {} and {})", offset, s1.text.size(), s2.text.size());
+        }
+        return message;
+    }
+
+
+    template<typename L, typename R>
+    struct BinaryExpression;
+
+    /**
+     * @struct ExpressionLhs
+     * @brief First operand of an expression captured by M_CHECK/M_REQUIRE
+     * @details Produced by `Decomposer{} <= a`. Comparing it with a second
+     *          operand evaluates the comparison once and keeps references to
+     *          both operands, which live until the end of the full expression
+     *          of the check. Without a comparison, the operand itself is
+     *          tested for truth.
+     */
+    template<typename L>
+    struct ExpressionLhs {
+        const L& lhs;
+
+        template<typename R> friend BinaryExpression<L, R> operator==(ExpressionLhs&& e, const R& rhs) { return { e.lhs, rhs, "==", static_cast<bool>(e.lhs == rhs) }; }
+        template<typename R> friend BinaryExpression<L, R> operator!=(ExpressionLhs&& e, const R& rhs) { return { e.lhs, rhs, "!=", static_cast<bool>(e.lhs != rhs) }; }
+        template<typename R> friend BinaryExpression<L, R> operator<(ExpressionLhs&& e, const R& rhs) { return { e.lhs, rhs, "<", static_cast<bool>(e.lhs < rhs) }; }
+        template<typename R> friend BinaryExpression<L, R> operator<=(ExpressionLhs&& e, const R& rhs) { return { e.lhs, rhs, "<=", static_cast<bool>(e.lhs <= rhs) }; }
+        template<typename R> friend BinaryExpression<L, R> operator>(ExpressionLhs&& e, const R& rhs) { return { e.lhs, rhs, ">", static_cast<bool>(e.lhs > rhs) }; }
+        template<typename R> friend BinaryExpression<L, R> operator>=(ExpressionLhs&& e, const R& rhs) { return { e.lhs, rhs, ">=", static_cast<bool>(e.lhs >= rhs) }; }
+
+        // `a && b` and `a || b` would be evaluated before the check could see them
+        template<typename R> friend void operator&&(ExpressionLhs&&, const R&) = delete;
+        template<typename R> friend void operator||(ExpressionLhs&&, const R&) = delete;
+    };
+
+    /**
+     * @struct BinaryExpression
+     * @brief Comparison captured by M_CHECK/M_REQUIRE, with its operands and outcome
+     */
+    template<typename L, typename R>
+    struct BinaryExpression {
+        const L& lhs;
+        const R& rhs;
+        std::string_view op;    ///< Spelling of the comparison operator
+        bool result;            ///< Outcome of the comparison
+    };
+
+    /**
+     * @struct Decomposer
+     * @brief Start of an expression captured by M_CHECK/M_REQUIRE
+     * @details `Decomposer{} <= a == b` parses as `(Decomposer{} <= a) == b`,
+     *          since `<=` binds tighter than `==` and, being left-associative,
+     *          takes the first operand of `<`, `<=`, `>` and `>=` as well.
+     */
+    struct Decomposer {
+        template<typename L>
+        friend ExpressionLhs<L> operator<=(Decomposer, const L& lhs) noexcept { return { lhs }; }
+    };
+
+    /**
+     * @brief Check a comparison captured by M_CHECK/M_REQUIRE
+     * @param expression The captured comparison
+     * @param text Source text of the checked expression
+     * @return The failure message with both operand values, or std::nullopt if it holds
+     */
+    template<typename L, typename R>
+    std::optional<std::string> check_expression(const BinaryExpression<L, R>& expression, const std::string_view text) {
+        if (expression.result) return std::nullopt;
+        return std::format("Expected: {}\nActual: {} {} {}", text,
+            detail::format_operand(expression.lhs), expression.op, detail::format_operand(expression.rhs));
+    }
+
+    /**
+     * @brief Check a single operand captured by M_CHECK/M_REQUIRE for truth
+     * @param expression The captured operand
+     * @param text Source text of the checked expression
+     * @return The failure message with the operand value, or std::nullopt if it is true
+     */
+    template<typename L>
+    std::optional<std::string> check_expression(const ExpressionLhs<L>& expression, const std::string_view text) {
+        if (static_cast<bool>(expression.lhs)) return std::nullopt;
+        return std::format("Expected: {}\nActual: {}", text, detail::format_operand(expression.lhs));
+    }
+
+    /**
+     * @brief Count an allocation in the AllocationScopes of the calling thread
+     * @param size Requested size in bytes
+     * @details Called by the replacement `operator new` of the macros header
+     *          (see VCT_TEST_UNIT_ALLOCATION_HOOKS). Outside of a scope this
+     *          is a thread-local load and a branch.
+     */
+    void record_allocation(const std::size_t size) noexcept {
+        auto* counter = detail::allocation_counter;
+        if (counter == nullptr || detail::in_allocation_hook) [[likely]] return;
+
+        const bool first = counter->count == 0;
+        for (auto* scope = counter; scope != nullptr; scope = scope->outer) {
+            if (scope->count++ == 0) scope->first_size = size;
+            scope->bytes += size;
+        }
+        if (first && detail::capture_allocation_stacks.load(std::memory_order_relaxed)) {
+            detail::in_allocation_hook = true;
+            try {
+                counter->first_stack = std::to_string(std::stacktrace::current(2));
+            } catch (...) {
+                counter->first_stack.clear();
+            }
+            detail::in_allocation_hook = false;
+        }
+    }
+
+    /// Mark the allocation hooks as compiled into the program, done by the macros header
+    void set_allocation_hooks_installed() noexcept {
+        detail::allocation_hooks_installed.store(true, std::memory_order_relaxed);
+    }
+
+    /**
+     * @class AllocationScope
+     * @brief Counts the allocations made by the current thread while it is alive
+     * @details Used by M_EXPECT_NO_ALLOC and M_EXPECT_MAX_ALLOCS. Scopes nest;
+     *          an allocation counts in every enclosing scope of its thread.
+     *          Allocations of other threads are not counted.
+     */
+    class AllocationScope {
+    public:
+        AllocationScope() noexcept {
+            m_counter.outer = std::exchange(detail::allocation_counter, &m_counter);
+        }
+
+        AllocationScope(const AllocationScope&) = delete;
+        AllocationScope& operator=(const AllocationScope&) = delete;
+
+        ~AllocationScope() { stop(); }
+
+        /// Stop counting; later calls have no effect
+        void stop() noexcept {
+            if (!m_active) return;
+            detail::allocation_counter = m_counter.outer;
+            m_active = false;
+        }
+
+        std::size_t count() const noexcept { return m_counter.count; }
+        std::size_t bytes() const noexcept { return m_counter.bytes; }
+
+        /**
+         * @brief Stop counting and check the number of allocations
+         * @param max_allocations Allowed number of allocations
+         * @param statement Source text of the checked statement
+         * @return The failure message, or std::nullopt if the limit holds
+         */
+        std::optional<std::string> check(const std::size_t max_allocations, const std::string_view statement) {
+            stop();
+            if (!detail::allocation_hooks_installed.load(std::memory_order_relaxed)) {
+                return std::format("Cannot count the allocations of {}: define VCT_TEST_UNIT_ALLOCATION_HOOKS "
+                    "before including the macros header in one translation unit", statement);
+            }
+            if (m_counter.count <= max_allocations) return std::nullopt;
+
+            auto message = std::format("Expected: at most {} allocation{} in {}\nActual: {} allocation{} of {} bytes in total, the first of {} bytes",
+                max_allocations, max_allocations != 1 ? "s" : "", statement,
+                m_counter.count, m_counter.count != 1 ? "s" : "", m_counter.bytes, m_counter.first_size);
+            if (!m_counter.first_stack.empty()) message += std::format(", allocated at:\n{}", m_counter.first_stack);
+            return message;
+        }
+
+    private:
+        detail::AllocationCounter m_counter{};
+        bool m_active{ true };
+    };
+
+    /**
+     * @struct TestOptions
+     * @brief Per-test settings, given as optional designated initializers to M_TEST
+     * @details Usage: M_TEST(Suite, Name, .timeout = std::chrono::seconds{ 5 }) { ... }
+     */
+    struct TestOptions {
+        std::chrono::milliseconds timeout{ 0 };     ///< Maximum run time, 0 = use RunOptions::timeout
+    };
+
+    /**
+     * @struct SuiteHooks
+     * @brief Once-per-suite setup and teardown functions of a test fixture
+     * @details Filled in by M_TEST_F from the fixture's static
+     *          SetUpTestSuite() and TearDownTestSuite(). Null for plain M_TEST
+     *          cases.
+     */
+    struct SuiteHooks {
+        void (*set_up)() {};            ///< Called before the first test of the suite
+        void (*tear_down)() {};         ///< Called after the last test of the suite
+    };
+
+    /**
+     * @class Test
+     * @brief Base class of test fixtures used with M_TEST_F
+     * @details Each test of a fixture runs on a new instance: SetUp(), the
+     *          test body, then TearDown(), which also runs if SetUp() or the
+     *          body failed. Hide the static SetUpTestSuite() and
+     *          TearDownTestSuite() in the fixture to share expensive state
+     *          (kept in static members) between the tests of the suite; they
+     *          run once per suite, also when the suite's tests are spread over
+     *          parallel workers, and may be protected. Plain M_TEST cases of
+     *          the same suite run between them as well. Usage:
+     * @code
+     * class Storage : public vct::test::unit::Test {
+     * protected:
+     *     static void SetUpTestSuite() { dataset = load_dataset(); }
+     *     static void TearDownTestSuite() { dataset.reset(); }
+     *     void SetUp() override { cache.clear(); }
+     *     static inline std::unique_ptr<Dataset> dataset;
+     *     Cache cache;
+     * };
+     * M_TEST_F(Storage, Lookup) { M_EXPECT_TRUE(dataset->contains(42)); }
+     * @endcode
+     */
+    class Test {
+    public:
+        virtual ~Test() = default;
+
+        static void SetUpTestSuite() {}
+        static void TearDownTestSuite() {}
+
+        /// Runs SetUp(), the test body and TearDown(), rethrowing the first exception
+        void run() {
+            std::exception_ptr error;
+            try {
+                SetUp();
+                TestBody();
+            } catch (...) {
+                error = std::current_exception();
+            }
+            try {
+                TearDown();
+            } catch (...) {
+                if (!error) throw;
+            }
+            if (error) std::rethrow_exception(error);
+        }
+
+    protected:
+        virtual void SetUp() {}
+        virtual void TearDown() {}
+
+    private:
+        virtual void TestBody() = 0;
+    };
+
+    /**
+     * @class ParamVisitor
+     * @brief Receives the instances of a parameterized test from run_params()
+     */
+    class ParamVisitor {
+    public:
+        /**
+         * @brief Run one parameter instance
+         * @param index Position of the parameter in the parameter range
+         * @param body Runs the test body with that parameter
+         * @return false to stop generating parameters
+         */
+        virtual bool visit(std::size_t index, const std::function<void()>& body) = 0;
+
+    protected:
+        ~ParamVisitor() = default;
+    };
+
+    /**
+     * @brief Instance generator of a parameterized test, instantiated by M_TEST_P
+     * @tparam Source Function returning the parameter range, e.g. a std::generator
+     * @tparam Body Test function taking one parameter
+     * @param visitor Runs each instance
+     * @details Parameters are pulled from the range one at a time as the
+     *          runner reaches them, so neither the parameters nor per-instance
+     *          test cases are materialized.
+     */
+    template<auto Source, auto Body>
+    void run_params(ParamVisitor& visitor) {
+        std::size_t index = 0;
+        for (auto&& param : Source()) {
+            if (!visitor.visit(index++, [&] { Body(param); })) return;
+        }
+    }
 
     /**
      * @struct TestCase
@@ -68,6 +781,28 @@ export namespace vct::test::unit{
     struct TestCase {
         std::string name{};             ///< The name of the test case
         std::function<void()> func{};   ///< The test function to execute
+        TestOptions options{};          ///< Per-test settings
+        SuiteHooks hooks{};             ///< Suite fixture hooks, set by M_TEST_F
+        void (*params)(ParamVisitor&) {};   ///< Instance generator set by M_TEST_P, replaces `func`
+    };
+
+    /**
+     * @struct TestDescriptor
+     * @brief Constant-initialized description of a section-registered test case
+     * @details With VCT_TEST_UNIT_SECTION_REGISTRATION defined, M_TEST emits one
+     *          constant descriptor per test and a pointer to it into the
+     *          `vct_test_unit` linker section, instead of inserting a TestCase
+     *          into get_test_registry(). The runner walks the section directly,
+     *          so registration performs no dynamic allocation and runs no
+     *          per-test static constructor.
+     */
+    struct TestDescriptor {
+        std::string_view suite{};       ///< The name of the test suite
+        std::string_view name{};        ///< The name of the test case
+        void (*func)() {};              ///< The test function to execute
+        TestOptions options{};          ///< Per-test settings
+        SuiteHooks hooks{};             ///< Suite fixture hooks, set by M_TEST_F
+        void (*params)(ParamVisitor&) {};   ///< Instance generator set by M_TEST_P, replaces `func`
     };
 
     /**
@@ -86,131 +821,4814 @@ export namespace vct::test::unit{
     }
 
     /**
-     * @brief Start and execute all registered tests
-     * @return The number of failed tests (0 if all tests passed)
-     * @details Executes all test cases registered in the global test registry.
-     *          Provides GTest-compatible output formatting with detailed timing
-     *          information and comprehensive failure reporting.
-     * 
-     * Test execution flow:
-     * 1. Enumerate all registered test suites and cases
-     * 2. Execute each test case with precise timing measurement
-     * 3. Handle different exception types (Assert, Expect, Unknown)
-     * 4. Generate detailed reports with pass/fail statistics
-     * 
-     * Output format matches Google Test for compatibility with CI/CD systems.
-     * 
-     * @note This function is typically called from main() in test executables
-     * @see get_test_registry() for the underlying test storage mechanism
+     * @struct Types
+     * @brief Compile-time list of the types an M_TYPED_TEST is instantiated for
      */
-    int start() {
-        // Get all registered test suites and cases
-        const auto& test_suites = get_test_registry();
-        
+    template<typename... Ts>
+    struct Types {};
 
-        // Test execution statistics
-        std::size_t passed = 0;                    ///< Number of tests that passed
-        std::vector<std::string> failures;         ///< Names of failed tests
-        std::size_t total_tests = 0;               ///< Total number of test cases
-        std::size_t total_suites = test_suites.size(); ///< Total number of test suites
-        
-        // Count total test cases across all suites
-        for (const auto& [suite_name, cases] : test_suites) {
-            total_tests += cases.size();
-        }
-        
-        // Print test execution header in GTest-compatible format
-        std::println( "[==========] Running {} test{} from {} test suite{}.", 
-            total_tests, total_tests > 1 ? "s" : "", total_suites, total_suites > 1 ? "s" : ""
-        );
-        std::println("[----------] Global test environment set-up.");
-        const auto total_begin = std::chrono::steady_clock::now();
-
-        // Execute each test suite
-        for(const auto& [suite_name, cases] : test_suites) {
-            if (cases.empty()) continue;
-            
-            // Print suite header
-            std::println( "[----------] {} test{} from {}", 
-                cases.size(), cases.size() > 1 ? "s" : "", suite_name
-            );
-            const auto suit_begin = std::chrono::steady_clock::now();
-            
-            // Execute each test case in the suite
-            for(const auto& [case_name, func] : cases) {
-                const std::string full_name = suite_name + "." + case_name;
-                std::println("[ RUN      ] {}", full_name);
-                
-                // Measure test execution time with high precision
-                const auto begin = std::chrono::steady_clock::now();
-                try {
-                    func(); // Execute the test function
-
-                    // Test passed successfully
-                    const auto end = std::chrono::steady_clock::now();
-                    const auto time = std::chrono::duration_cast<std::chrono::milliseconds>(end-begin).count();
-                    std::println("[       OK ] {}  ({} ms)", full_name, time);
-                    passed++;
-                } catch (const AssertException& e) {
-                    // Assertion failure - terminate test suite execution
-                    const auto end = std::chrono::steady_clock::now();
-                    const auto time = std::chrono::duration_cast<std::chrono::milliseconds>(end-begin).count();
-                    std::println("[  ASSERT  ] {}  ({} ms)", full_name, time/1000);
-                    std::println("[  FAILED  ] {}", e.what());
-                    return static_cast<int>(total_tests - passed);
-                }
-                catch (const ExpectException& e) {
-                    // Expectation failure - continue with next test
-                    const auto end = std::chrono::steady_clock::now();
-                    const auto time = std::chrono::duration_cast<std::chrono::milliseconds>(end-begin).count();
-                    std::println("[  EXPECT  ] {}  ({} ms)", full_name, time/1000);
-                    std::println("[  FAILED  ] {}", e.what());
-                    failures.emplace_back(full_name);
-                }
-                catch (const std::exception& e) {
-                    // Unknown exception - treat as test failure
-                    const auto end = std::chrono::steady_clock::now();
-                    const auto time = std::chrono::duration_cast<std::chrono::milliseconds>(end-begin).count();
-                    std::println("[ UNKNOWN  ] {}  ({} ms)", full_name, time/1000);
-                    std::println("[  FAILED  ] {}", e.what());
-                    failures.emplace_back(full_name);
-                }
-            }
-            // Print suite completion summary
-            const auto suit_end = std::chrono::steady_clock::now();
-            const auto suit_time = std::chrono::duration_cast<std::chrono::milliseconds>(suit_end-suit_begin).count();
-            
-            std::println( "[----------] {} test{} from {} ({} ms total)", 
-                cases.size(), cases.size() != 1 ? "s" : "", suite_name, suit_time
-            );
-            std::println("");
-        }
+    /**
+     * @brief Readable name of a type, computed at compile time
+     * @return The compiler's spelling of T without inline namespaces such as
+     *         `__cxx11`, e.g. "int" or "std::basic_string<char>"
+     */
+    template<typename T>
+    constexpr std::string_view type_name() noexcept {
+        return { detail::type_name_storage<T>.data(), detail::type_name_storage<T>.size() };
+    }
 
-        // Print final test execution summary
-        const auto total_end = std::chrono::steady_clock::now();
-        const auto total_time = std::chrono::duration_cast<std::chrono::milliseconds>(total_end-total_begin).count();
-        std::println("[----------] Global test environment tear-down");
-        std::println(
-            "[==========] {} test{} from {} test suite{} ran. ({} ms total)", 
-            total_tests, total_tests != 1 ? "s" : "",
-            total_suites, total_suites != 1 ? "s" : "", total_time
-        );
+    /**
+     * @brief Name of the instance of a typed test for one type
+     * @tparam Test The class template generated by M_TYPED_TEST
+     * @return "Name<Type>", e.g. "push_back<int>"
+     */
+    template<template<typename> class Test, typename T>
+    constexpr std::string_view typed_test_name() noexcept {
+        return { detail::typed_test_name_storage<Test, T>.data(), detail::typed_test_name_storage<Test, T>.size() };
+    }
 
-        // Print pass/fail statistics
-        std::println("[  PASSED  ] {} test{}.", passed, passed > 1 ? "s" : "");
-        
-        // Print detailed failure list if any tests failed
-        if (!failures.empty()) {
-            std::println("[  FAILED  ] {} test{}, listed below:", failures.size(), failures.size() > 1 ? "s" : "");
-            for (const auto& test_name : failures) {
-                std::println("[  FAILED  ] {}", test_name);
-            }
-            std::println("");
-            std::println("{} FAILED TEST{}", failures.size(), failures.size() > 1 ? "S" : "");
-        }
-        
-        // Return the number of failed tests (0 = success, >0 = failure count)
-        return static_cast<int>(failures.size());
+    /**
+     * @brief Register one test case per type of a typed test, used by M_TYPED_TEST
+     * @tparam Test The class template generated by M_TYPED_TEST
+     * @tparam Ts The types to instantiate the test body for
+     */
+    template<template<typename> class Test, typename... Ts>
+    void register_typed_test(Types<Ts...>) {
+        (get_test_registry()[std::string{ Test<Ts>::suite }].push_back({
+            std::string{ typed_test_name<Test, Ts>() }, &Test<Ts>::run
+        }), ...);
+    }
+
+    /**
+     * @struct TypedTestDescriptors
+     * @brief Constant descriptors of a typed test, one per type (linker section mode)
+     * @details `pointers` is copied into the `vct_test_unit` section by
+     *          M_TYPED_TEST, next to the single pointers emitted by M_TEST.
+     */
+    template<template<typename> class Test, typename List>
+    struct TypedTestDescriptors;
+
+    template<template<typename> class Test, typename... Ts>
+    struct TypedTestDescriptors<Test, Types<Ts...>> {
+        static_assert(sizeof...(Ts) > 0, "M_TYPED_TEST needs at least one type");
+
+        static constexpr TestDescriptor descriptors[]{
+            { Test<Ts>::suite, typed_test_name<Test, Ts>(), &Test<Ts>::run }...
+        };
+
+        static constexpr std::array<const TestDescriptor*, sizeof...(Ts)> pointers = [] {
+            std::array<const TestDescriptor*, sizeof...(Ts)> result{};
+            for (std::size_t i = 0; i < result.size(); ++i) result[i] = &descriptors[i];
+            return result;
+        }();
+    };
+
+
+    /**
+     * @brief Get the set of test suites that must not run concurrently
+     * @return Reference to the global set of serial suite names
+     * @details Suites listed here are executed one test at a time on the main
+     *          thread, after the parallel part of a `--jobs` run has finished.
+     *          This set is populated by the M_TEST_SUITE_SERIAL macro and has
+     *          no effect on serial runs.
+     */
+    std::set<std::string, std::less<>>& get_serial_suites() {
+        static std::set<std::string, std::less<>> suites;
+        return suites;
+    }
+
+    /**
+     * @class Environment
+     * @brief Global test environment, set up once before and torn down once after all tests
+     * @details Register instances with get_environments(). With `--isolate`
+     *          or `--zygote`, SetUp() runs in the runner process before any
+     *          worker is forked, so workers start from the prepared state.
+     */
+    class Environment {
+    public:
+        virtual ~Environment() = default;
+        virtual void SetUp() {}
+        virtual void TearDown() {}
+    };
+
+    /**
+     * @brief Get the global test environments
+     * @return Reference to the environment list
+     * @details start() calls SetUp() of each environment in order before the
+     *          first test and TearDown() in reverse order after the last. If a
+     *          SetUp() fails, no test is run.
+     */
+    std::vector<std::unique_ptr<Environment>>& get_environments() {
+        static std::vector<std::unique_ptr<Environment>> environments;
+        return environments;
+    }
+
+    /**
+     * @brief Prevent the compiler from optimizing away a value
+     * @param value The value that must be considered used
+     * @details Forces `value` to be materialized in a register or memory, so
+     *          that the computation producing it cannot be folded away by the
+     *          optimizer. Intended for use inside M_BENCHMARK bodies.
+     */
+    template<typename T>
+    inline void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static const volatile void* sink{};
+        sink = std::addressof(value);
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+    }
+
+    /**
+     * @brief Prevent the compiler from optimizing away a value, or assuming it unchanged
+     * @param value The value that must be considered used and possibly modified
+     */
+    template<typename T>
+    inline void DoNotOptimize(T& value) {
+#if defined(__clang__)
+        asm volatile("" : "+r,m"(value) : : "memory");
+#elif defined(__GNUC__)
+        asm volatile("" : "+m,r"(value) : : "memory");
+#else
+        static volatile void* sink{};
+        sink = std::addressof(value);
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+    }
+
+    /**
+     * @brief Force all pending memory writes to be considered observable
+     * @details Acts as a compiler-level memory barrier: stores performed before
+     *          the call cannot be eliminated as dead, and loads after the call
+     *          cannot reuse values cached before it.
+     */
+    inline void ClobberMemory() {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : : "memory");
+#else
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+    }
+
+    /**
+     * @class LatencyHistogram
+     * @brief Log-bucketed histogram of nanosecond latencies with bounded memory
+     * @details HDR-style layout: values below 128 are counted exactly, larger
+     *          ones in 64 linear sub-buckets per power of two, so every
+     *          reported percentile is within 1/64 (1.6%) of the recorded value.
+     *          The whole 64-bit range takes 3776 counters (30 KB), allocated
+     *          once on construction; recording never allocates.
+     */
+    class LatencyHistogram {
+    public:
+        LatencyHistogram() : m_counts(bucket_count) {}
+
+        /// Count one latency in nanoseconds
+        void record(const std::uint64_t value) noexcept {
+            ++m_counts[index_of(value)];
+            ++m_total;
+            m_min = std::min(m_min, value);
+            m_max = std::max(m_max, value);
+        }
+
+        /**
+         * @brief Count one latency of a fixed-rate loop, correcting for coordinated omission
+         * @param value Measured latency in nanoseconds
+         * @param expected_interval Interval between the intended starts of two operations
+         * @details A stalled operation also delays the operations that should
+         *          have started meanwhile, which a closed loop never measures.
+         *          Like HdrHistogram's recordValueWithExpectedInterval(), this
+         *          adds the latencies those operations would have seen:
+         *          value - interval, value - 2 * interval, ... down to the interval.
+         */
+        void record(const std::uint64_t value, const std::uint64_t expected_interval) noexcept {
+            record(value);
+            if (expected_interval == 0 || value <= expected_interval) return;
+            for (std::uint64_t missing = value - expected_interval; missing >= expected_interval; missing -= expected_interval) {
+                record(missing);
+            }
+        }
+
+        /// Add all values recorded by another histogram
+        void merge(const LatencyHistogram& other) noexcept {
+            for (std::size_t i = 0; i < bucket_count; ++i) m_counts[i] += other.m_counts[i];
+            m_total += other.m_total;
+            m_min = std::min(m_min, other.m_min);
+            m_max = std::max(m_max, other.m_max);
+        }
+
+        /// Number of recorded values
+        std::uint64_t count() const noexcept { return m_total; }
+
+        /// Smallest recorded value, 0 if empty
+        std::uint64_t min() const noexcept { return m_total > 0 ? m_min : 0; }
+
+        /// Largest recorded value, exact
+        std::uint64_t max() const noexcept { return m_max; }
+
+        /**
+         * @brief Get the value below or at which a share of the recorded values lies
+         * @param percentile e.g. 99.9
+         * @return The highest value of the bucket holding the percentile, 0 if empty
+         */
+        std::uint64_t percentile(const double percentile) const noexcept {
+            if (m_total == 0) return 0;
+            const auto rank = std::max<std::uint64_t>(1,
+                static_cast<std::uint64_t>(std::ceil(std::clamp(percentile, 0.0, 100.0) / 100 * static_cast<double>(m_total))));
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < bucket_count; ++i) {
+                seen += m_counts[i];
+                if (seen >= rank) return std::min(highest_equivalent(i), m_max);
+            }
+            return m_max;
+        }
+
+    private:
+        static constexpr unsigned sub_bucket_bits = 7;
+        static constexpr std::size_t half_bucket = std::size_t{ 1 } << (sub_bucket_bits - 1);
+        static constexpr std::size_t bucket_count = (64 - sub_bucket_bits + 2) * half_bucket;
+
+        /// Values up to 2^7 map to themselves, larger ones to (shift, top 7 bits)
+        static std::size_t index_of(const std::uint64_t value) noexcept {
+            if (value < 2 * half_bucket) return static_cast<std::size_t>(value);
+            const auto shift = static_cast<unsigned>(std::bit_width(value)) - sub_bucket_bits;
+            return shift * half_bucket + static_cast<std::size_t>(value >> shift);
+        }
+
+        /// Largest value counted in a bucket
+        static std::uint64_t highest_equivalent(const std::size_t index) noexcept {
+            if (index < 2 * half_bucket) return index;
+            const auto shift = static_cast<unsigned>(index / half_bucket - 1);
+            const std::uint64_t sub_bucket = index - shift * half_bucket;
+            return ((sub_bucket + 1) << shift) - 1;
+        }
+
+        std::vector<std::uint64_t> m_counts;
+        std::uint64_t m_total{};
+        std::uint64_t m_min{ std::numeric_limits<std::uint64_t>::max() };
+        std::uint64_t m_max{};
+    };
+
+    /**
+     * @class BenchmarkState
+     * @brief Iteration driver passed to every M_BENCHMARK body
+     * @details The benchmark body loops over the state, and only that loop is
+     *          timed:
+     *          @code
+     *          M_BENCHMARK(Vector, PushBack) {
+     *              for (auto _ : state) {
+     *                  std::vector<int> v;
+     *                  v.push_back(42);
+     *                  vct::test::unit::DoNotOptimize(v);
+     *              }
+     *          }
+     *          @endcode
+     *          The number of iterations is chosen by the runner's calibration loop.
+     *
+     *          Per-operation latencies go into a histogram, reported with
+     *          percentiles: every iteration with `--benchmark-histogram`
+     *          (adding a clock reading to each), or whatever the body passes
+     *          to record_latency().
+     */
+    class BenchmarkState {
+    public:
+        using clock = std::chrono::steady_clock;
+
+        /**
+         * @struct Iterator
+         * @brief Counting iterator of the benchmark loop, stops the timer on exit
+         */
+        struct Iterator {
+            /// Loop variable type of `for (auto _ : state)`, never meant to be used
+            struct [[maybe_unused]] Value {};
+
+            BenchmarkState* state{};
+            std::size_t remaining{};
+
+            Value operator*() const noexcept { return {}; }
+            Iterator& operator++() noexcept { --remaining; return *this; }
+            bool operator!=(std::default_sentinel_t) {
+                if (state->m_time_iterations) [[unlikely]] state->time_iteration(remaining);
+                if (remaining != 0) [[likely]] return true;
+                state->finish();
+                return false;
+            }
+        };
+
+        /// Reads a monotonic event count measured alongside the timer, e.g. retired instructions
+        using Meter = std::function<std::uint64_t()>;
+
+        /**
+         * @struct Context
+         * @brief Measurement setup of one run of the benchmark body, provided by the runner
+         */
+        struct Context {
+            const Meter* meter{};               ///< Event counter read where the timer is; must outlive the state
+            LatencyHistogram* latencies{};      ///< Receives the recorded latencies
+            bool time_iterations{ false };      ///< Record the time of every iteration into `latencies`
+            std::size_t thread_index{ 0 };      ///< Index of the running thread in a multi-threaded run
+            std::size_t threads{ 1 };           ///< Number of threads running the body concurrently
+            std::barrier<>* start{};            ///< Releases the loops of all threads together
+        };
+
+        /**
+         * @brief Create a state that runs the benchmark loop a fixed number of times
+         * @param iterations Number of loop iterations
+         * @param context Meter, latency recording and thread setup of the run
+         */
+        BenchmarkState(const std::size_t iterations, const Context& context) noexcept
+            : m_iterations(iterations), m_meter(context.meter), m_latencies(context.latencies),
+              m_time_iterations(context.latencies != nullptr && context.time_iterations),
+              m_thread_index(context.thread_index), m_threads(context.threads), m_start(context.start) {}
+
+        /// Create a state for a single-threaded run without meter or latency recording
+        explicit BenchmarkState(const std::size_t iterations) noexcept : BenchmarkState(iterations, Context{}) {}
+
+        BenchmarkState(const BenchmarkState&) = delete;
+        BenchmarkState& operator=(const BenchmarkState&) = delete;
+
+        /**
+         * @brief Start the timer and begin the benchmark loop
+         * @details In a multi-threaded run, first waits until every thread
+         *          has reached its loop, so setup before the loop is not
+         *          measured and all threads contend from the start.
+         */
+        Iterator begin() {
+            if (m_start) std::exchange(m_start, nullptr)->arrive_and_wait();
+            m_started = true;
+            m_begin = clock::now();
+            if (m_meter) m_meter_begin = (*m_meter)();
+            return { this, m_iterations };
+        }
+
+        std::default_sentinel_t end() const noexcept { return {}; }
+
+        /**
+         * @brief Stop the timer, e.g. around per-iteration setup that must not be measured
+         * @note Every call must be paired with resume_timing(). With a meter,
+         *       each pause adds the cost of reading it to the measurement.
+         */
+        void pause_timing() {
+            if (m_meter) m_meter_pause_begin = (*m_meter)();
+            m_pause_begin = clock::now();
+        }
+
+        /// Restart the timer after pause_timing()
+        void resume_timing() {
+            m_paused += clock::now() - m_pause_begin;
+            if (m_meter) m_meter_paused += (*m_meter)() - m_meter_pause_begin;
+        }
+
+        /**
+         * @brief Record the latency of one operation, e.g. a request of a load loop
+         * @details Ignored during calibration and warmup.
+         */
+        void record_latency(const std::chrono::nanoseconds latency) noexcept {
+            if (m_latencies) m_latencies->record(static_cast<std::uint64_t>(std::max<std::int64_t>(latency.count(), 0)));
+        }
+
+        /**
+         * @brief Record the latency of one operation of a fixed-rate loop
+         * @param latency Time from the intended start of the operation to its end
+         * @param expected_interval Intended time between two operations
+         * @details Corrects for coordinated omission, see LatencyHistogram::record().
+         */
+        void record_latency(const std::chrono::nanoseconds latency, const std::chrono::nanoseconds expected_interval) noexcept {
+            if (m_latencies) {
+                m_latencies->record(static_cast<std::uint64_t>(std::max<std::int64_t>(latency.count(), 0)),
+                    static_cast<std::uint64_t>(std::max<std::int64_t>(expected_interval.count(), 0)));
+            }
+        }
+
+        /// Number of iterations the benchmark loop runs, on each thread
+        std::size_t iterations() const noexcept { return m_iterations; }
+
+        /// Index of the running thread in [0, threads()), e.g. to split producers and consumers
+        std::size_t thread_index() const noexcept { return m_thread_index; }
+
+        /// Number of threads running the body concurrently
+        std::size_t threads() const noexcept { return m_threads; }
+
+        /// Whether the benchmark loop was started
+        bool started() const noexcept { return m_started; }
+
+        /// Whether the benchmark loop was run to completion
+        bool finished() const noexcept { return m_finished; }
+
+        /// Measured time of the benchmark loop, excluding paused periods
+        clock::duration elapsed() const noexcept { return m_end - m_begin - m_paused; }
+
+        /// Meter count of the benchmark loop, excluding paused periods; 0 without a meter
+        std::uint64_t metered() const noexcept { return m_meter_end - m_meter_begin - m_meter_paused; }
+
+    private:
+        void finish() {
+            if (m_meter) m_meter_end = (*m_meter)();
+            m_end = clock::now();
+            m_finished = m_started;
+        }
+
+        /// Record the time since the previous loop check, excluding paused periods
+        void time_iteration(const std::size_t remaining) noexcept {
+            const auto now = clock::now();
+            if (remaining != m_iterations) {
+                const auto elapsed = now - m_iteration_begin - (m_paused - m_iteration_paused);
+                m_latencies->record(static_cast<std::uint64_t>(
+                    std::max<std::int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(), 0)));
+            }
+            m_iteration_begin = now;
+            m_iteration_paused = m_paused;
+        }
+
+        std::size_t m_iterations{};
+        bool m_started{ false };
+        bool m_finished{ false };
+        clock::time_point m_begin{};
+        clock::time_point m_end{};
+        clock::time_point m_pause_begin{};
+        clock::duration m_paused{};
+        const Meter* m_meter{};
+        std::uint64_t m_meter_begin{}, m_meter_end{}, m_meter_pause_begin{}, m_meter_paused{};
+        LatencyHistogram* m_latencies{};
+        bool m_time_iterations{ false };
+        clock::time_point m_iteration_begin{};
+        clock::duration m_iteration_paused{};
+        std::size_t m_thread_index{ 0 };
+        std::size_t m_threads{ 1 };
+        std::barrier<>* m_start{};
+    };
+
+    /**
+     * @struct BenchmarkOptions
+     * @brief Per-benchmark settings, given as optional designated initializers to M_BENCHMARK
+     * @details Usage: M_BENCHMARK(Queue, Push, .min_threads = 1, .max_threads = 8) { ... }
+     *          The body runs concurrently on 1, 2, 4, ... threads up to
+     *          `max_threads`, each count reported as "Name/threads:N" and
+     *          summarized in a scaling table. With `max_threads` = 0, the run
+     *          on all hardware threads is reported as "Name/threads:max", so
+     *          that its baseline entry matches on machines with other core
+     *          counts; which smaller counts run still depends on the machine.
+     */
+    struct BenchmarkOptions {
+        std::size_t min_threads{ 1 };
+        std::size_t max_threads{ 1 };   ///< 0 = one per hardware thread
+        bool pin_threads{ false };      ///< Pin thread i to the i-th allowed CPU (Linux only)
+    };
+
+    /**
+     * @struct BenchmarkCase
+     * @brief Represents a single benchmark within a benchmark suite
+     * @details Benchmarks are registered with the M_BENCHMARK macro, organized
+     *          into suites the same way as test cases, and executed by start()
+     *          in `--benchmark` mode.
+     */
+    struct BenchmarkCase {
+        std::string name{};                             ///< The name of the benchmark
+        std::function<void(BenchmarkState&)> func{};    ///< The benchmark function to execute
+        BenchmarkOptions options{};                     ///< Thread counts and pinning
+    };
+
+    /**
+     * @brief Get the global benchmark registry singleton
+     * @return Reference to the global benchmark registry map
+     * @details Maps suite names to benchmarks, mirroring get_test_registry().
+     *          Populated by the M_BENCHMARK macro during static initialization.
+     */
+    std::map<std::string, std::vector<BenchmarkCase>>& get_benchmark_registry() {
+        // Maps suite name to benchmarks
+        static std::map<std::string, std::vector<BenchmarkCase>> registry;
+        return registry;
+    }
+
+    /**
+     * @enum TimeUnit
+     * @brief Unit used for durations in the test report
+     */
+    enum class TimeUnit : std::uint8_t {
+        Nanoseconds,                    ///< "ns"
+        Microseconds,                   ///< "us"
+        Milliseconds                    ///< "ms", GTest default
+    };
+
+    /**
+     * @enum BenchmarkMetric
+     * @brief Quantity measured per benchmark iteration
+     * @details Retired instructions barely depend on the load of the
+     *          machine, so they can detect changes of 1-2% even on noisy CI
+     *          runners where times vary far more. Cycles follow the time more
+     *          closely but vary with the cache and branch predictor state.
+     */
+    enum class BenchmarkMetric : std::uint8_t {
+        Time,                           ///< Wall time in nanoseconds
+        Instructions,                   ///< Retired user-space instructions (Linux only)
+        Cycles                          ///< User-space CPU cycles (Linux only)
+    };
+
+    /**
+     * @struct RunOptions
+     * @brief Options controlling how start() executes the registered tests
+     * @details Can be filled in directly or parsed from the command line
+     *          with parse_options().
+     */
+    struct RunOptions {
+        std::size_t jobs{ 1 };          ///< Number of worker threads or processes (1 = serial run, 0 = hardware concurrency)
+        bool isolate{ false };          ///< Run each test in a pre-forked worker process (POSIX only)
+        std::size_t zygote{ 0 };        ///< Tests per process forked from the set-up runner, 0 = off (POSIX only)
+        std::chrono::milliseconds timeout{ 0 };     ///< Timeout of tests without their own, 0 = none
+        std::chrono::milliseconds global_timeout{ 0 };  ///< Wall-clock limit of the whole run, 0 = none
+        TimeUnit time_unit{ TimeUnit::Milliseconds };   ///< Unit of reported test, suite and total durations
+        bool async_output{ true };      ///< Deliver reporter events on a background thread
+        bool text_output{ true };       ///< Print the default TextReporter output besides get_reporters()
+        std::vector<std::string> outputs{};     ///< Result files as "xml:PATH" (JUnit) or "json:PATH"
+        bool allocation_stacks{ false };        ///< Record the stack of the first allocation failing M_EXPECT_NO_ALLOC
+        bool perf_counters{ false };    ///< Count instructions, cycles and misses of each test and benchmark (Linux only)
+
+        std::string filter{};           ///< GTest-style "POSITIVE[-NEGATIVE]" glob patterns, empty = all tests
+        bool list{ false };             ///< Only print the selected test names, do not run them
+
+        std::size_t shard_index{ 0 };   ///< Index of the shard to run, in [0, shard_count)
+        std::size_t shard_count{ 1 };   ///< Total number of shards (1 = no sharding)
+        std::string shard_durations{};  ///< File of historical durations used to balance shards by time
+        std::string record_durations{}; ///< File to write the durations of this run to
+
+        bool benchmark{ false };        ///< Run registered benchmarks instead of tests
+        std::chrono::milliseconds benchmark_warmup{ 100 };      ///< Warmup time per benchmark
+        std::chrono::milliseconds benchmark_min_time{ 10 };     ///< Minimum measured time per sample
+        std::size_t benchmark_repetitions{ 20 };                ///< Number of samples per benchmark
+        BenchmarkMetric benchmark_metric{ BenchmarkMetric::Time };  ///< Quantity measured per iteration
+        std::string benchmark_out{};    ///< File to write the benchmark samples of this run to
+        std::string benchmark_compare{};    ///< Baseline file written by an earlier run with `benchmark_out`
+        std::optional<double> benchmark_threshold{};    ///< Fail on significant regressions above this many percent, must not be negative
+        bool benchmark_histogram{ false };  ///< Time every benchmark iteration and report latency percentiles
+    };
+
+    /**
+     * @brief Parse test runner options from command line arguments
+     * @param argc Argument count as passed to main()
+     * @param argv Argument vector as passed to main()
+     * @return The parsed run options
+     * @details Recognized arguments:
+     *          - `--jobs=N` / `-jN` : run tests on N worker threads (0 = one per hardware thread)
+     *          - `--isolate` : run tests in N pre-forked worker processes, surviving crashes
+     *          - `--zygote[=B]` : set up environments and suites once, then fork a process per test (or per B tests)
+     *          - `--timeout=MS` : default per-test timeout in milliseconds (0 = none)
+     *          - `--global-timeout=MS` : abort the run after MS milliseconds in total (0 = none)
+     *          - `--time-unit=ns|us|ms` : unit of reported durations
+     *          - `--sync-output` : report from the test thread, keeping output of tests in line
+     *          - `--output=xml:PATH` / `--output=json:PATH` : also stream results to a JUnit XML or JSON file (repeatable)
+     *          - `--allocation-stacks` : show where the first allocation failing an allocation check was made
+     *          - `--perf-counters` : report performance counters of each test and benchmark (Linux only)
+     *          - `--filter=PATTERNS` : run only tests matching GTest-style globs, e.g. `Math.*:Io.*-*.Slow`
+     *          - `--list` : print the selected tests instead of running them
+     *          - `--shard-index=I` / `--shard-count=N` : run only the I-th of N disjoint parts of the tests
+     *          - `--shard-durations=FILE` : balance shards by the durations recorded in FILE
+     *          - `--record-durations=FILE` : write "Suite.Case milliseconds" lines for this run
+     *          - `--benchmark` : run benchmarks instead of tests
+     *          - `--benchmark-warmup=MS` : warmup time per benchmark in milliseconds
+     *          - `--benchmark-min-time=MS` : minimum measured time per sample in milliseconds
+     *          - `--benchmark-repetitions=N` : number of samples per benchmark
+     *          - `--benchmark-metric=time|instructions|cycles` : quantity measured per benchmark iteration
+     *          - `--benchmark-out=FILE` : write the benchmark results as a baseline to FILE
+     *          - `--benchmark-compare=FILE` : report the changes against a baseline written by `--benchmark-out`
+     *          - `--benchmark-threshold=PCT` : fail if a benchmark got significantly slower than the baseline by more than PCT percent
+     *          - `--benchmark-histogram` : time every benchmark iteration and report its latency percentiles
+     *
+     *          The GTest environment variables `GTEST_FILTER`, `GTEST_SHARD_INDEX`
+     *          and `GTEST_TOTAL_SHARDS` are honored as defaults for the filter
+     *          and shard options.
+     *
+     *          Unrecognized arguments are ignored so that test executables can
+     *          accept their own flags.
+     */
+    RunOptions parse_options(const int argc, const char* const argv[]) {
+        RunOptions options;
+
+        const auto parse_number = [](std::string_view text, auto& out) {
+            std::remove_reference_t<decltype(out)> value{};
+            const auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+            if (ec == std::errc{} && ptr == text.data() + text.size()) out = value;
+        };
+        const auto parse_millis = [&](std::string_view text, std::chrono::milliseconds& out) {
+            auto count = out.count();
+            parse_number(text, count);
+            out = std::chrono::milliseconds{ count };
+        };
+
+        // Filter and sharding environment compatible with GTest-aware CI runners
+        if (const char* filter = std::getenv("GTEST_FILTER")) options.filter = filter;
+        if (const char* index = std::getenv("GTEST_SHARD_INDEX")) parse_number(index, options.shard_index);
+        if (const char* count = std::getenv("GTEST_TOTAL_SHARDS")) parse_number(count, options.shard_count);
+
+        for (int i = 1; i < argc; ++i) {
+            const std::string_view arg{ argv[i] };
+            if (arg.starts_with("--jobs=")) parse_number(arg.substr(7), options.jobs);
+            else if (arg.starts_with("-j")) parse_number(arg.substr(2), options.jobs);
+            else if (arg == "--isolate") options.isolate = true;
+            else if (arg == "--zygote") options.zygote = 1;
+            else if (arg.starts_with("--zygote=")) parse_number(arg.substr(9), options.zygote);
+            else if (arg == "--sync-output") options.async_output = false;
+            else if (arg.starts_with("--output=")) options.outputs.emplace_back(arg.substr(9));
+            else if (arg == "--allocation-stacks") options.allocation_stacks = true;
+            else if (arg == "--perf-counters") options.perf_counters = true;
+            else if (arg.starts_with("--filter=")) options.filter = arg.substr(9);
+            else if (arg == "--list") options.list = true;
+            else if (arg.starts_with("--timeout=")) parse_millis(arg.substr(10), options.timeout);
+            else if (arg.starts_with("--global-timeout=")) parse_millis(arg.substr(17), options.global_timeout);
+            else if (arg == "--time-unit=ns") options.time_unit = TimeUnit::Nanoseconds;
+            else if (arg == "--time-unit=us") options.time_unit = TimeUnit::Microseconds;
+            else if (arg == "--time-unit=ms") options.time_unit = TimeUnit::Milliseconds;
+            else if (arg.starts_with("--shard-index=")) parse_number(arg.substr(14), options.shard_index);
+            else if (arg.starts_with("--shard-count=")) parse_number(arg.substr(14), options.shard_count);
+            else if (arg.starts_with("--shard-durations=")) options.shard_durations = arg.substr(18);
+            else if (arg.starts_with("--record-durations=")) options.record_durations = arg.substr(19);
+            else if (arg == "--benchmark") options.benchmark = true;
+            else if (arg.starts_with("--benchmark-warmup=")) parse_millis(arg.substr(19), options.benchmark_warmup);
+            else if (arg.starts_with("--benchmark-min-time=")) parse_millis(arg.substr(21), options.benchmark_min_time);
+            else if (arg.starts_with("--benchmark-repetitions=")) parse_number(arg.substr(24), options.benchmark_repetitions);
+            else if (arg == "--benchmark-metric=time") options.benchmark_metric = BenchmarkMetric::Time;
+            else if (arg == "--benchmark-metric=instructions") options.benchmark_metric = BenchmarkMetric::Instructions;
+            else if (arg == "--benchmark-metric=cycles") options.benchmark_metric = BenchmarkMetric::Cycles;
+            else if (arg.starts_with("--benchmark-out=")) options.benchmark_out = arg.substr(16);
+            else if (arg.starts_with("--benchmark-compare=")) options.benchmark_compare = arg.substr(20);
+            else if (arg == "--benchmark-histogram") options.benchmark_histogram = true;
+            else if (arg.starts_with("--benchmark-threshold=")) {
+                // Left NaN if not a number, so that run_benchmarks() rejects it instead of gating at 0%
+                double threshold = std::numeric_limits<double>::quiet_NaN();
+                parse_number(arg.substr(22), threshold);
+                options.benchmark_threshold = threshold;
+            }
+        }
+
+        return options;
+    }
+
+}
+
+
+namespace vct::test::unit::detail {
+
+    /**
+     * @struct PlannedTest
+     * @brief A test case flattened out of the registry, together with its suite name
+     */
+    struct PlannedTest {
+        std::string_view suite{};       ///< Name of the owning suite
+        std::string_view name{};        ///< Name of the test case
+        const TestCase* test{};         ///< Registry test case, nullptr for section-registered tests
+        void (*func)() {};              ///< Test function of a section-registered test
+        TestOptions options{};          ///< Per-test settings
+        SuiteHooks hooks{};             ///< Suite fixture hooks, null for plain tests
+        void (*params)(ParamVisitor&) {};   ///< Instance generator of a parameterized test
+    };
+
+    /// Bounds of the `vct_test_unit` linker section, set by set_test_section()
+    const TestDescriptor* const* section_first = nullptr;
+    const TestDescriptor* const* section_last = nullptr;
+
+    /**
+     * @class TestFilter
+     * @brief Precompiled GTest-style test filter
+     * @details The filter `POSITIVE[-NEGATIVE]` holds `:`-separated glob
+     *          patterns over "Suite.Case" names, where `*` matches any string
+     *          and `?` any single character. A double `::` does not separate
+     *          patterns, so that typed tests such as `Suite.Case<std::string>`
+     *          can be selected by their exact name. A test is selected if it matches
+     *          a positive pattern (all tests if there are none) and no
+     *          negative one. Patterns are classified once, so the common
+     *          forms `Suite.Case`, `Suite.*` and `*.Case` are matched with a
+     *          single comparison instead of the general glob algorithm.
+     */
+    class TestFilter {
+    public:
+        /// Filter selecting all tests
+        TestFilter() = default;
+
+        /**
+         * @brief Compile a filter expression
+         * @param filter e.g. "Math.*:Io.Read*-Math.Slow*"
+         */
+        explicit TestFilter(const std::string_view filter) {
+            const auto dash = filter.find('-');
+            compile(filter.substr(0, dash), m_positive);
+            if (dash != std::string_view::npos) compile(filter.substr(dash + 1), m_negative);
+            // "*" alone selects everything, as does an empty positive part
+            if (std::ranges::any_of(m_positive, [](const Pattern& p) { return p.kind == Pattern::Kind::Prefix && p.text.empty(); })) {
+                m_positive.clear();
+            }
+        }
+
+        /// Whether every test is selected, so that matching can be skipped
+        bool matches_all() const noexcept { return m_positive.empty() && m_negative.empty(); }
+
+        /// Whether the test named "Suite.Case" is selected
+        bool matches(const std::string_view full_name) const noexcept {
+            const auto match = [&](const Pattern& p) { return p.match(full_name); };
+            return (m_positive.empty() || std::ranges::any_of(m_positive, match))
+                && std::ranges::none_of(m_negative, match);
+        }
+
+    private:
+        struct Pattern {
+            enum class Kind : std::uint8_t {
+                Exact,                  ///< No wildcards
+                Prefix,                 ///< Single trailing `*`
+                Suffix,                 ///< Single leading `*`
+                Glob                    ///< Anything else
+            };
+            Kind kind{ Kind::Exact };
+            std::string text{};         ///< Pattern without the wildcard for Prefix/Suffix
+
+            bool match(const std::string_view name) const noexcept {
+                switch (kind) {
+                case Kind::Exact: return name == text;
+                case Kind::Prefix: return name.starts_with(text);
+                case Kind::Suffix: return name.ends_with(text);
+                case Kind::Glob: break;
+                }
+                return glob(text, name);
+            }
+        };
+
+        static void compile(std::string_view patterns, std::vector<Pattern>& out) {
+            while (!patterns.empty()) {
+                auto colon = patterns.find(':');
+                while (colon != std::string_view::npos && colon + 1 < patterns.size() && patterns[colon + 1] == ':') {
+                    colon = patterns.find(':', colon + 2);
+                }
+                const auto text = patterns.substr(0, colon);
+                patterns = colon == std::string_view::npos ? std::string_view{} : patterns.substr(colon + 1);
+                if (text.empty()) continue;
+
+                const auto wildcards = std::ranges::count_if(text, [](const char c) { return c == '*' || c == '?'; });
+                if (wildcards == 0) out.push_back({ Pattern::Kind::Exact, std::string{ text } });
+                else if (wildcards == 1 && text.back() == '*') out.push_back({ Pattern::Kind::Prefix, std::string{ text.substr(0, text.size() - 1) } });
+                else if (wildcards == 1 && text.front() == '*') out.push_back({ Pattern::Kind::Suffix, std::string{ text.substr(1) } });
+                else out.push_back({ Pattern::Kind::Glob, std::string{ text } });
+            }
+        }
+
+        /// Glob match with single-star backtracking, linear for patterns with one `*`
+        static bool glob(const std::string_view pattern, const std::string_view name) noexcept {
+            std::size_t p = 0, n = 0;
+            std::size_t star = std::string_view::npos, resume = 0;
+            while (n < name.size()) {
+                if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == name[n])) {
+                    ++p;
+                    ++n;
+                } else if (p < pattern.size() && pattern[p] == '*') {
+                    star = p++;
+                    resume = n;
+                } else if (star != std::string_view::npos) {
+                    p = star + 1;
+                    n = ++resume;
+                } else {
+                    return false;
+                }
+            }
+            while (p < pattern.size() && pattern[p] == '*') ++p;
+            return p == pattern.size();
+        }
+
+        std::vector<Pattern> m_positive;
+        std::vector<Pattern> m_negative;
+    };
+
+    /**
+     * @brief Flatten the registered tests selected by a filter into a single list ordered by suite name
+     * @param filter Selects the tests to keep
+     * @return Tests of the registry and of the linker section; within a suite,
+     *         registry tests come first in registration order, then section
+     *         tests in link order
+     */
+    std::vector<PlannedTest> flatten_tests(const TestFilter& filter = {}) {
+        const auto& test_suites = get_test_registry();
+
+        std::size_t count = static_cast<std::size_t>(section_last - section_first);
+        for (const auto& [suite_name, cases] : test_suites) count += cases.size();
+
+        // Reused buffer for the "Suite.Case" name matched by the filter
+        std::string full_name;
+        const auto selected = [&](const std::string_view suite, const std::string_view name) {
+            if (filter.matches_all()) return true;
+            full_name.assign(suite);
+            full_name += '.';
+            full_name += name;
+            return filter.matches(full_name);
+        };
+
+        std::vector<PlannedTest> plan;
+        plan.reserve(count);
+        for (const auto& [suite_name, cases] : test_suites) {
+            for (const auto& test : cases) {
+                if (selected(suite_name, test.name)) plan.push_back({ suite_name, test.name, &test, nullptr, test.options, test.hooks, test.params });
+            }
+        }
+        for (auto it = section_first; it != section_last; ++it) {
+            // Null entries are alignment padding between the contributions of different objects
+            if (*it == nullptr) continue;
+            const TestDescriptor& test = **it;
+            if (selected(test.suite, test.name)) plan.push_back({ test.suite, test.name, nullptr, test.func, test.options, test.hooks, test.params });
+        }
+        if (section_first != section_last) {
+            std::ranges::stable_sort(plan, {}, &PlannedTest::suite);
+        }
+        // Plain tests of a fixture's suite run inside its hooks too, whichever test registered them
+        for (auto first = plan.begin(); first != plan.end();) {
+            const auto last = std::ranges::find_if(first, plan.end(), [&](const PlannedTest& test) { return test.suite != first->suite; });
+            const auto fixture = std::ranges::find_if(first, last, [](const PlannedTest& test) {
+                return test.hooks.set_up != nullptr || test.hooks.tear_down != nullptr;
+            });
+            if (fixture != last) {
+                const auto hooks = fixture->hooks;
+                for (auto it = first; it != last; ++it) it->hooks = hooks;
+            }
+            first = last;
+        }
+        return plan;
+    }
+
+    /// Historical test durations in milliseconds, keyed by "Suite.Case"
+    using DurationMap = std::map<std::string, double, std::less<>>;
+
+    /**
+     * @brief Load historical test durations
+     * @param path File with one "Suite.Case milliseconds" entry per line
+     * @return The durations; later lines override earlier ones, so files of
+     *         several shards can simply be concatenated
+     * @details The duration is the last field, so names of typed tests may
+     *          contain spaces, e.g. "Suite.Case<std::pair<int, int>> 1.250".
+     */
+    DurationMap load_durations(const std::string& path) {
+        DurationMap durations;
+        std::ifstream file{ path };
+        std::string line;
+        while (std::getline(file, line)) {
+            const auto split = line.find_last_of(" \t");
+            if (split == std::string::npos) continue;
+            const auto end = line.find_last_not_of(" \t", split);
+            const std::string_view name = std::string_view{ line }.substr(0, end == std::string::npos ? 0 : end + 1);
+            const std::string_view value = std::string_view{ line }.substr(split + 1);
+            double ms{};
+            const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), ms);
+            if (ec == std::errc{} && !name.empty()) durations.insert_or_assign(std::string{ name }, ms);
+        }
+        return durations;
+    }
+
+    /**
+     * @brief Keep only the tests that belong to one shard
+     * @param plan The flattened plan, identical on every shard
+     * @param shard_index Index of this shard in [0, shard_count)
+     * @param shard_count Total number of shards
+     * @param durations Historical durations; if empty, tests are dealt round-robin
+     * @return The tests of this shard, in plan order
+     * @details With durations, tests are assigned longest first to the shard
+     *          with the smallest accumulated time (ties go to the lower shard
+     *          index). Tests without history are assumed to take the median
+     *          known duration. Every shard computes the same assignment, so
+     *          the shards are disjoint and cover the whole plan.
+     */
+    std::vector<PlannedTest> select_shard(
+        std::vector<PlannedTest> plan,
+        const std::size_t shard_index,
+        const std::size_t shard_count,
+        const DurationMap& durations
+    ) {
+        if (shard_count <= 1) return plan;
+
+        std::vector<std::size_t> owner(plan.size());
+        if (durations.empty()) {
+            for (std::size_t i = 0; i < plan.size(); ++i) owner[i] = i % shard_count;
+        } else {
+            std::vector<double> known;
+            known.reserve(durations.size());
+            for (const auto& [name, ms] : durations) known.push_back(ms);
+            std::ranges::nth_element(known, known.begin() + static_cast<std::ptrdiff_t>(known.size() / 2));
+            const double fallback = known[known.size() / 2];
+
+            std::vector<std::pair<double, std::size_t>> weighted(plan.size());
+            for (std::size_t i = 0; i < plan.size(); ++i) {
+                const auto it = durations.find(std::format("{}.{}", plan[i].suite, plan[i].name));
+                weighted[i] = { it != durations.end() ? it->second : fallback, i };
+            }
+            // Longest first, ties in plan order
+            std::ranges::sort(weighted, [](const auto& a, const auto& b) {
+                return a.first != b.first ? a.first > b.first : a.second < b.second;
+            });
+
+            std::vector<double> load(shard_count, 0.0);
+            for (const auto& [ms, i] : weighted) {
+                const auto lightest = std::ranges::min_element(load) - load.begin();
+                owner[i] = static_cast<std::size_t>(lightest);
+                load[owner[i]] += ms;
+            }
+        }
+
+        std::vector<PlannedTest> shard;
+        for (std::size_t i = 0; i < plan.size(); ++i) {
+            if (owner[i] == shard_index) shard.push_back(plan[i]);
+        }
+        return shard;
+    }
+
+    /// Whether run_guarded() and the benchmarks collect performance counters (`--perf-counters`)
+    std::atomic<bool> perf_counters_enabled{ false };
+
+    /**
+     * @class PerfCounters
+     * @brief Performance counter group of one thread, read before and after each test
+     * @details Opens the hardware counters with perf_event_open, or the
+     *          software counters if no hardware counter can be scheduled
+     *          (common in containers and virtual machines). The group counts
+     *          continuously from the first use on; results are differences of
+     *          two readings, each a single read() of the whole group.
+     */
+    class PerfCounters {
+    public:
+        static constexpr std::size_t max_counters = 4;
+
+        /// Counter totals at one point in time
+        struct Snapshot {
+            std::array<std::uint64_t, max_counters> values{};
+        };
+
+        /**
+         * @brief Get the counters of the calling thread, opened on first use
+         * @details Reopened in a forked process, where inherited counters
+         *          still measure the thread of the parent.
+         */
+        static PerfCounters& local() {
+            thread_local std::optional<PerfCounters> counters;
+#if defined(_M_VCT_TEST_UNIT_PERF_EVENTS)
+            if (counters && counters->m_pid != ::getpid()) counters.reset();
+#endif
+            if (!counters) counters.emplace();
+            return *counters;
+        }
+
+        PerfCounters() {
+#if defined(_M_VCT_TEST_UNIT_PERF_EVENTS)
+            m_pid = ::getpid();
+            using enum PerfCounter;
+            if (open({ Instructions, Cycles, CacheMisses, BranchMisses }) && scheduled()) return;
+            close();
+            if (!open({ TaskClock, PageFaults, ContextSwitches })) close();
+#else
+            m_error = "not supported on this platform";
+#endif
+        }
+
+        /**
+         * @brief Open exactly the given counters of the calling thread, without fallback
+         * @details Used for the benchmark metrics; check counters() for success.
+         */
+        explicit PerfCounters([[maybe_unused]] const std::initializer_list<PerfCounter> counters) {
+#if defined(_M_VCT_TEST_UNIT_PERF_EVENTS)
+            m_pid = ::getpid();
+            if (!open(counters)) close();
+#else
+            m_error = "not supported on this platform";
+#endif
+        }
+
+        PerfCounters(const PerfCounters&) = delete;
+        PerfCounters& operator=(const PerfCounters&) = delete;
+
+        ~PerfCounters() { close(); }
+
+        /// The opened counters, empty if none is available
+        std::span<const PerfCounter> counters() const noexcept { return { m_counters.data(), m_count }; }
+
+        /// Whether only software counters could be opened
+        bool software_only() const noexcept { return m_count > 0 && m_counters[0] == PerfCounter::TaskClock; }
+
+        /// Why no counter could be opened, empty if some are available
+        const std::string& error() const noexcept { return m_error; }
+
+        /// Read the current totals of the group, scaled if it was multiplexed
+        Snapshot read() const noexcept {
+            Snapshot snapshot;
+#if defined(_M_VCT_TEST_UNIT_PERF_EVENTS)
+            if (m_count == 0) return snapshot;
+            // PERF_FORMAT_GROUP layout: nr, time enabled, time running, one value per counter
+            std::array<std::uint64_t, 3 + max_counters> buffer{};
+            if (::read(m_fds[0], buffer.data(), sizeof(buffer)) < static_cast<::ssize_t>((3 + m_count) * sizeof(std::uint64_t))) {
+                return snapshot;
+            }
+            const double scale = buffer[2] > 0 && buffer[2] < buffer[1]
+                ? static_cast<double>(buffer[1]) / static_cast<double>(buffer[2]) : 1.0;
+            for (std::size_t i = 0; i < m_count; ++i) {
+                snapshot.values[i] = static_cast<std::uint64_t>(static_cast<double>(buffer[3 + i]) * scale);
+            }
+#endif
+            return snapshot;
+        }
+
+        /// Counts accumulated since an earlier snapshot of the same thread
+        std::vector<CounterValue> since(const Snapshot& begin) const {
+            const Snapshot end = read();
+            std::vector<CounterValue> values;
+            values.reserve(m_count);
+            for (std::size_t i = 0; i < m_count; ++i) {
+                values.push_back({ m_counters[i], end.values[i] - std::min(begin.values[i], end.values[i]) });
+            }
+            return values;
+        }
+
+    private:
+#if defined(_M_VCT_TEST_UNIT_PERF_EVENTS)
+        /// Open the counters as one group, led by the first; false if any of them fails
+        bool open(const std::initializer_list<PerfCounter> counters) {
+            for (const PerfCounter counter : counters) {
+                perf_event_attr attr{};
+                attr.size = sizeof(attr);
+                switch (counter) {
+                case PerfCounter::Instructions: attr.type = PERF_TYPE_HARDWARE; attr.config = PERF_COUNT_HW_INSTRUCTIONS; break;
+                case PerfCounter::Cycles: attr.type = PERF_TYPE_HARDWARE; attr.config = PERF_COUNT_HW_CPU_CYCLES; break;
+                case PerfCounter::CacheMisses: attr.type = PERF_TYPE_HARDWARE; attr.config = PERF_COUNT_HW_CACHE_MISSES; break;
+                case PerfCounter::BranchMisses: attr.type = PERF_TYPE_HARDWARE; attr.config = PERF_COUNT_HW_BRANCH_MISSES; break;
+                case PerfCounter::TaskClock: attr.type = PERF_TYPE_SOFTWARE; attr.config = PERF_COUNT_SW_TASK_CLOCK; break;
+                case PerfCounter::PageFaults: attr.type = PERF_TYPE_SOFTWARE; attr.config = PERF_COUNT_SW_PAGE_FAULTS; break;
+                case PerfCounter::ContextSwitches: attr.type = PERF_TYPE_SOFTWARE; attr.config = PERF_COUNT_SW_CONTEXT_SWITCHES; break;
+                }
+                attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+                // Hardware counters of user space only; software events such as
+                // context switches happen in the kernel, and are only restricted
+                // to user space if perf_event_paranoid requires it
+                attr.exclude_kernel = attr.type == PERF_TYPE_HARDWARE;
+                attr.exclude_hv = 1;
+
+                const int group = m_count == 0 ? -1 : m_fds[0];
+                long fd = ::syscall(SYS_perf_event_open, &attr, 0, -1, group, PERF_FLAG_FD_CLOEXEC);
+                if (fd < 0 && errno == EACCES && !attr.exclude_kernel) {
+                    attr.exclude_kernel = 1;
+                    fd = ::syscall(SYS_perf_event_open, &attr, 0, -1, group, PERF_FLAG_FD_CLOEXEC);
+                }
+                if (fd < 0) {
+                    m_error = std::format("perf_event_open failed for {}: {}", counter_name(counter), ::strerror(errno));
+                    return false;
+                }
+                m_fds[m_count] = static_cast<int>(fd);
+                m_counters[m_count++] = counter;
+            }
+            m_error.clear();
+            return true;
+        }
+
+        /// Whether the group gets time on the PMU; some hypervisors accept hardware counters that never run
+        bool scheduled() const noexcept {
+            std::array<std::uint64_t, 3 + max_counters> buffer{};
+            volatile std::uint64_t sink = 0;
+            for (std::uint64_t i = 0; i < 100'000; ++i) sink = sink + i;
+            return ::read(m_fds[0], buffer.data(), sizeof(buffer)) > 0 && buffer[2] > 0;
+        }
+#endif
+
+        void close() noexcept {
+#if defined(_M_VCT_TEST_UNIT_PERF_EVENTS)
+            while (m_count > 0) ::close(m_fds[--m_count]);
+#endif
+            m_count = 0;
+        }
+
+        std::array<int, max_counters> m_fds{};
+        std::array<PerfCounter, max_counters> m_counters{};
+        std::size_t m_count{};
+        std::string m_error{};
+#if defined(_M_VCT_TEST_UNIT_PERF_EVENTS)
+        ::pid_t m_pid{};
+#endif
+    };
+
+    /**
+     * @brief Execute a test body and capture its outcome
+     * @param body Callable executed with failure recording enabled on this thread
+     * @return The outcome with begin/end timestamps, and counters if enabled
+     */
+    template<typename Body>
+    TestResult run_guarded(Body&& body) {
+        TestResult result;
+        TestResult* const outer = std::exchange(current_result, &result);
+        const bool counting = perf_counters_enabled.load(std::memory_order_relaxed);
+        const auto counters_begin = counting ? PerfCounters::local().read() : PerfCounters::Snapshot{};
+        result.begin = clock::now();
+        try {
+            body();
+            result.end = clock::now();
+            if (!result.failures.empty()) result.outcome = TestResult::Outcome::Expect;
+        } catch (const AssertException& e) {
+            result.end = clock::now();
+            result.outcome = TestResult::Outcome::Assert;
+            result.failures.push_back({ e.what() });
+        } catch (const ExpectException& e) {
+            result.end = clock::now();
+            result.outcome = TestResult::Outcome::Expect;
+            result.failures.push_back({ e.what() });
+        } catch (const std::exception& e) {
+            result.end = clock::now();
+            result.outcome = TestResult::Outcome::Unknown;
+            result.failures.push_back({ e.what() });
+        }
+        if (counting) result.counters = PerfCounters::local().since(counters_begin);
+        current_result = outer;
+        return result;
+    }
+
+    /**
+     * @brief Execute a single planned test case and capture its outcome
+     * @param test The test case to run
+     * @return The outcome with begin/end timestamps
+     */
+    TestResult run_test(const PlannedTest& test) {
+        if (test.test != nullptr) return run_guarded(test.test->func);
+        return run_guarded(test.func);
+    }
+
+    /**
+     * @struct ResultSink
+     * @brief Receives the results of a planned test as they become available
+     * @details A plain test produces one result. A parameterized test
+     *          produces one per parameter instance, plus one without a
+     *          parameter index if generating the parameters fails.
+     */
+    struct ResultSink {
+        std::function<void(std::size_t)> on_instance{};    ///< Called before a parameter instance runs
+        std::function<bool(TestResult&&)> on_result{};     ///< Receives each result; returning false stops the test
+    };
+
+    /**
+     * @brief Execute a planned test, plain or parameterized
+     * @param test The test case to run
+     * @param sink Receives the results
+     * @return false if the sink requested a stop
+     */
+    bool run_test(const PlannedTest& test, const ResultSink& sink) {
+        if (test.params == nullptr) return sink.on_result(run_test(test));
+
+        class Instances final : public ParamVisitor {
+        public:
+            explicit Instances(const ResultSink& sink) noexcept : m_sink(sink) {}
+
+            bool visit(const std::size_t index, const std::function<void()>& body) override {
+                if (m_sink.on_instance) m_sink.on_instance(index);
+                auto result = run_guarded(body);
+                result.param_index = index;
+                keep_going = m_sink.on_result(std::move(result));
+                return keep_going;
+            }
+
+            bool keep_going{ true };
+
+        private:
+            const ResultSink& m_sink;
+        } instances{ sink };
+
+        // Failures outside the instances come from the parameter range itself
+        auto generation = run_guarded([&] { test.params(instances); });
+        if (generation.outcome == TestResult::Outcome::Passed) return instances.keep_going;
+        generation.failures.insert(generation.failures.begin(), { "generating the parameters failed" });
+        return sink.on_result(std::move(generation));
+    }
+
+    /**
+     * @class Environments
+     * @brief Sets up the registered global environments and tears them down in reverse order
+     * @details Environments still set up on destruction (e.g. when an
+     *          assertion failure ended the run) are torn down then.
+     */
+    class Environments {
+    public:
+        Environments() = default;
+        Environments(const Environments&) = delete;
+        Environments& operator=(const Environments&) = delete;
+        ~Environments() { tear_down(); }
+
+        /**
+         * @brief Call SetUp() of each environment, stopping at the first failure
+         * @return Description of the failure, if any
+         */
+        std::optional<std::string> set_up() {
+            for (const auto& environment : get_environments()) {
+                // Counted first, so that a failed SetUp() still gets its TearDown()
+                ++m_set_up;
+                auto result = run_guarded([&] { environment->SetUp(); });
+                if (result.outcome != TestResult::Outcome::Passed) return describe(result);
+            }
+            return std::nullopt;
+        }
+
+        /**
+         * @brief Call TearDown() of the environments set up so far, last first
+         * @return Description of the first failure, if any
+         */
+        std::optional<std::string> tear_down() {
+            std::optional<std::string> error;
+            const auto& environments = get_environments();
+            for (; m_set_up > 0; --m_set_up) {
+                auto result = run_guarded([&] { environments[m_set_up - 1]->TearDown(); });
+                if (result.outcome != TestResult::Outcome::Passed && !error) error = describe(result);
+            }
+            return error;
+        }
+
+    private:
+        static std::string describe(const TestResult& result) {
+            return result.failures.empty() ? std::string{ "unknown error" } : result.failures.front().message;
+        }
+
+        std::size_t m_set_up{};
+    };
+
+    /**
+     * @brief Result of a test that was not run because SetUpTestSuite() failed
+     * @param set_up Outcome of the suite setup
+     * @param suite Name of the suite
+     */
+    TestResult suite_set_up_failure(const TestResult& set_up, const std::string_view suite) {
+        TestResult result = set_up;
+        result.failures.insert(result.failures.begin(), { std::format("SetUpTestSuite() of {} failed", suite) });
+        result.begin = result.end = clock::now();
+        return result;
+    }
+
+    /**
+     * @brief Add the failures of TearDownTestSuite() to the last test of the suite
+     * @param result Result of the last test of the suite
+     * @param tear_down Outcome of the suite teardown
+     * @param suite Name of the suite
+     */
+    void merge_suite_tear_down(TestResult& result, TestResult&& tear_down, const std::string_view suite) {
+        if (tear_down.outcome == TestResult::Outcome::Passed) return;
+        result.failures.push_back({ std::format("TearDownTestSuite() of {} failed", suite) });
+        std::ranges::move(tear_down.failures, std::back_inserter(result.failures));
+        // A failing teardown must not stop the run like an assertion in the test would
+        if (result.outcome == TestResult::Outcome::Passed) {
+            result.outcome = tear_down.outcome == TestResult::Outcome::Assert ? TestResult::Outcome::Expect : tear_down.outcome;
+        }
+    }
+
+    /**
+     * @class SuiteFixtures
+     * @brief Runs the SetUpTestSuite()/TearDownTestSuite() hooks around the tests of each suite
+     * @details A suite is set up by whichever thread first runs one of its
+     *          tests (std::call_once) and torn down by the thread finishing
+     *          its last planned test (atomic countdown), so the hooks run once
+     *          per suite even when its tests are spread over a worker pool.
+     *          A failing SetUpTestSuite() fails every test of the suite with
+     *          its failures; a failing TearDownTestSuite() fails the last test,
+     *          or adds a result of its own after a parameterized last test.
+     *          Suites still set up when the fixtures are destroyed (e.g. after
+     *          an assertion failure stopped the run) are torn down then.
+     */
+    class SuiteFixtures {
+    public:
+        /**
+         * @param plan The tests of the run, grouped by suite
+         */
+        explicit SuiteFixtures(const std::span<const PlannedTest> plan) : m_plan(plan), m_suite_of(plan.size()) {
+            for (std::size_t i = 0; i < plan.size(); ++i) {
+                if (i == 0 || plan[i].suite != plan[i - 1].suite) {
+                    m_suites.push_back(std::make_unique<Suite>());
+                    m_suites.back()->hooks = plan[i].hooks;
+                }
+                m_suite_of[i] = m_suites.size() - 1;
+                m_suites.back()->remaining.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        SuiteFixtures(const SuiteFixtures&) = delete;
+        SuiteFixtures& operator=(const SuiteFixtures&) = delete;
+
+        ~SuiteFixtures() { tear_down_remaining(); }
+
+        /**
+         * @brief Execute plan[index], setting up or tearing down its suite as needed
+         * @param index Index of the test in the plan
+         * @param sink Receives the outcomes of the test, including suite hook failures
+         * @return false if the sink requested a stop
+         */
+        bool run(const std::size_t index, const ResultSink& sink) {
+            const PlannedTest& test = m_plan[index];
+            Suite& suite = *m_suites[m_suite_of[index]];
+            if (suite.hooks.set_up == nullptr && suite.hooks.tear_down == nullptr) return run_test(test, sink);
+
+            std::call_once(suite.set_up_once, [&] {
+                if (suite.hooks.set_up != nullptr) suite.set_up_result = run_guarded(suite.hooks.set_up);
+                suite.set_up_done.store(true, std::memory_order_release);
+            });
+            const bool set_up = suite.set_up_result.outcome == TestResult::Outcome::Passed;
+            const auto last = [&] { return suite.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1; };
+
+            if (test.params == nullptr || !set_up) {
+                TestResult result = set_up ? run_test(test) : suite_set_up_failure(suite.set_up_result, test.suite);
+                if (last()) merge_suite_tear_down(result, tear_down(suite), test.suite);
+                return sink.on_result(std::move(result));
+            }
+
+            // Instances are reported as they finish, so teardown failures get their own result
+            const bool keep_going = run_test(test, sink);
+            if (last()) {
+                TestResult result;
+                result.begin = result.end = clock::now();
+                merge_suite_tear_down(result, tear_down(suite), test.suite);
+                if (keep_going && result.outcome != TestResult::Outcome::Passed) return sink.on_result(std::move(result));
+            }
+            return keep_going;
+        }
+
+        /**
+         * @brief Tear down the suite of plan[index] before its planned tests are all done
+         * @return Outcome of TearDownTestSuite(), passed if the suite was not
+         *         set up or is already torn down
+         * @details Used by worker processes, which only run a part of each suite.
+         */
+        TestResult tear_down_suite(const std::size_t index) {
+            Suite& suite = *m_suites[m_suite_of[index]];
+            if (!suite.set_up_done.load(std::memory_order_acquire)) return {};
+            return tear_down(suite);
+        }
+
+        /// Tear down all suites that were set up and not torn down yet, ignoring failures
+        void tear_down_remaining() {
+            for (auto& suite : m_suites) {
+                if (suite->set_up_done.load(std::memory_order_acquire)) tear_down(*suite);
+            }
+        }
+
+    private:
+        struct Suite {
+            SuiteHooks hooks{};
+            std::once_flag set_up_once;
+            TestResult set_up_result{};             ///< Outcome of SetUpTestSuite(), written once
+            std::atomic<bool> set_up_done{ false };
+            std::atomic<bool> torn_down{ false };
+            std::atomic<std::size_t> remaining{};   ///< Planned tests of the suite not finished yet
+        };
+
+        static TestResult tear_down(Suite& suite) {
+            if (suite.torn_down.exchange(true, std::memory_order_acq_rel) || suite.hooks.tear_down == nullptr) return {};
+            return run_guarded(suite.hooks.tear_down);
+        }
+
+        std::span<const PlannedTest> m_plan;
+        std::vector<std::size_t> m_suite_of;        ///< Index into m_suites for each planned test
+        std::vector<std::unique_ptr<Suite>> m_suites;
+    };
+
+    /**
+     * @brief Measure the cost of reading the clock
+     * @return Median time between two back-to-back clock::now() calls
+     */
+    clock::duration measure_timer_overhead() {
+        constexpr std::size_t samples = 1001;
+        std::array<clock::duration, samples> deltas;
+        for (auto& delta : deltas) {
+            const auto first = clock::now();
+            const auto second = clock::now();
+            delta = second - first;
+        }
+        std::ranges::nth_element(deltas, deltas.begin() + samples / 2);
+        return deltas[samples / 2];
+    }
+
+    /**
+     * @brief Format a duration in the given unit
+     * @return e.g. "12 us"
+     */
+    std::string format_duration(const clock::duration time, const TimeUnit unit) {
+        switch (unit) {
+        case TimeUnit::Nanoseconds:
+            return std::format("{} ns", std::chrono::duration_cast<std::chrono::nanoseconds>(time).count());
+        case TimeUnit::Microseconds:
+            return std::format("{} us", std::chrono::duration_cast<std::chrono::microseconds>(time).count());
+        case TimeUnit::Milliseconds:
+            break;
+        }
+        return std::format("{} ms", std::chrono::duration_cast<std::chrono::milliseconds>(time).count());
+    }
+
+    /**
+     * @struct TimeFormat
+     * @brief Converts measured durations to reported ones
+     * @details Subtracts the overhead of the timer itself, which otherwise
+     *          dominates tests running in a few microseconds, and formats the
+     *          result in the configured unit.
+     */
+    struct TimeFormat {
+        TimeUnit unit{ TimeUnit::Milliseconds };
+        clock::duration overhead{};     ///< Cost of one begin/end clock reading pair
+
+        /// Measured duration minus the timer overhead, never negative
+        clock::duration net(const clock::duration measured) const noexcept {
+            return measured > overhead ? measured - overhead : clock::duration::zero();
+        }
+
+        /// e.g. "12 us"
+        std::string operator()(const clock::duration measured) const {
+            return format_duration(net(measured), unit);
+        }
+    };
+
+    /**
+     * @brief Reported name of a test or of one instance of a parameterized test
+     * @param name Name of the test case
+     * @param param_index Parameter instance, if any
+     * @return `name`, or `name/param_index` for an instance
+     */
+    std::string instance_name(const std::string_view name, const std::optional<std::size_t> param_index) {
+        return param_index ? std::format("{}/{}", name, *param_index) : std::string{ name };
+    }
+
+    /// Lower-case name of an outcome as used in result files
+    std::string_view outcome_name(const TestResult::Outcome outcome) noexcept {
+        switch (outcome) {
+        case TestResult::Outcome::Passed: return "passed";
+        case TestResult::Outcome::Assert: return "assert";
+        case TestResult::Outcome::Expect: return "expect";
+        case TestResult::Outcome::Unknown: return "unknown";
+        case TestResult::Outcome::Crashed: return "crashed";
+        case TestResult::Outcome::Timeout: return "timeout";
+        }
+        return "unknown";
+    }
+
+    /// Duration in seconds as written to result files
+    double to_seconds(const clock::duration time) noexcept {
+        return std::chrono::duration<double>(time).count();
+    }
+
+    /**
+     * @brief Escape text for XML attribute values and character data
+     * @details Control characters that XML 1.0 cannot represent are replaced with '?'.
+     */
+    std::string escape_xml(const std::string_view text) {
+        std::string out;
+        out.reserve(text.size());
+        for (const char c : text) {
+            switch (c) {
+            case '&': out += "&amp;"; break;
+            case '<': out += "&lt;"; break;
+            case '>': out += "&gt;"; break;
+            case '"': out += "&quot;"; break;
+            case '\'': out += "&apos;"; break;
+            case '\t': case '\n': case '\r': out += c; break;
+            default: out += static_cast<unsigned char>(c) < 0x20 ? '?' : c; break;
+            }
+        }
+        return out;
+    }
+
+    /// Escape text for a JSON string literal
+    std::string escape_json(const std::string_view text) {
+        std::string out;
+        out.reserve(text.size());
+        for (const char c : text) {
+            switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) out += std::format("\\u{:04x}", static_cast<unsigned>(c));
+                else out += c;
+                break;
+            }
+        }
+        return out;
+    }
+
+    /**
+     * @class StreamingDocument
+     * @brief Result file that is a complete document after every write
+     * @details Each append() writes its content followed by the closing
+     *          trailer of the document and flushes. The next append() starts
+     *          writing where the trailer began, overwriting it. A run that
+     *          dies between two tests thus leaves a well-formed file holding
+     *          every finished test, and nothing but the offsets of the file
+     *          is kept in memory.
+     */
+    class StreamingDocument {
+    public:
+        explicit StreamingDocument(const std::string& path) : m_file(path, std::ios::binary | std::ios::trunc) {}
+
+        bool is_open() const { return m_file.is_open(); }
+
+        /// Current end of the content, i.e. the offset of the trailer
+        std::streamoff position() const noexcept { return m_end; }
+
+        /**
+         * @brief Append content and (re)write the trailer after it
+         * @param content Text to add at the end of the content
+         * @param trailer Closing text making the document complete
+         */
+        void append(const std::string_view content, const std::string_view trailer) {
+            if (!m_file) return;
+            m_file.seekp(m_end);
+            m_file.write(content.data(), static_cast<std::streamsize>(content.size()));
+            m_end += static_cast<std::streamoff>(content.size());
+            m_file.write(trailer.data(), static_cast<std::streamsize>(trailer.size()));
+            m_file.flush();
+        }
+
+        /**
+         * @brief Overwrite content written earlier, e.g. a reserved attribute area
+         * @param offset Offset returned by position() before the area was written
+         * @param text Replacement text, at most as long as the reserved area
+         */
+        void patch(const std::streamoff offset, const std::string_view text) {
+            if (!m_file) return;
+            m_file.seekp(offset);
+            m_file.write(text.data(), static_cast<std::streamsize>(text.size()));
+            m_file.flush();
+        }
+
+    private:
+        std::ofstream m_file;
+        std::streamoff m_end{};
+    };
+
+    /**
+     * @brief Format a duration given in nanoseconds with an adaptive unit
+     * @param ns Duration in nanoseconds
+     * @return e.g. "12.3 ns", "4.56 us", "7.89 ms"
+     */
+    std::string format_nanoseconds(const double ns) {
+        if (ns < 1e3) return std::format("{:.3g} ns", ns);
+        if (ns < 1e6) return std::format("{:.3g} us", ns / 1e3);
+        if (ns < 1e9) return std::format("{:.3g} ms", ns / 1e6);
+        return std::format("{:.3g} s", ns / 1e9);
+    }
+
+    /// Name of a benchmark metric in reports and baseline files
+    std::string_view metric_name(const BenchmarkMetric metric) noexcept {
+        switch (metric) {
+        case BenchmarkMetric::Time: return "time";
+        case BenchmarkMetric::Instructions: return "instructions";
+        case BenchmarkMetric::Cycles: return "cycles";
+        }
+        return "unknown";
+    }
+
+    /// e.g. "12.3 ns" for the time, "412.25" for counted metrics
+    std::string format_metric(const double value, const BenchmarkMetric metric) {
+        if (metric == BenchmarkMetric::Time) return format_nanoseconds(value);
+        return std::format("{:.6g}", value);
+    }
+
+}
+
+
+export namespace vct::test::unit {
+
+    /**
+     * @struct RunStartEvent
+     * @brief Reported once before the first test of a run
+     */
+    struct RunStartEvent {
+        std::size_t test_count{};       ///< Tests of this run (after sharding)
+        std::size_t suite_count{};      ///< Suites of this run
+        bool benchmarks{ false };       ///< Benchmark run (`--benchmark`), reporting BenchmarkEndEvent instead of TestEndEvent
+    };
+
+    /**
+     * @struct SuiteStartEvent
+     * @brief Reported before the first test of a suite
+     */
+    struct SuiteStartEvent {
+        std::string_view suite{};
+        std::size_t test_count{};       ///< Tests of the suite in this run, a parameterized test counting once
+    };
+
+    /**
+     * @struct TestStartEvent
+     * @brief Reported before the outcome of a test
+     * @details With `jobs` > 1 or `isolate`, tests are reported in plan order
+     *          once they have finished, so this event may come after the
+     *          test has actually run.
+     */
+    struct TestStartEvent {
+        std::string_view suite{};
+        std::string_view name{};
+        std::optional<std::size_t> param_index{};   ///< Parameter instance of an M_TEST_P test
+
+        /// `name`, or `name/param_index` for an instance of a parameterized test
+        std::string full_name() const { return detail::instance_name(name, param_index); }
+    };
+
+    /**
+     * @struct TestEndEvent
+     * @brief Reported when a test has finished
+     */
+    struct TestEndEvent {
+        std::string_view suite{};
+        std::string_view name{};
+        TestResult result{};            ///< Outcome and failures of the test
+        std::chrono::steady_clock::duration duration{};     ///< Run time without timer overhead
+
+        /// `name`, or `name/param_index` for an instance of a parameterized test
+        std::string full_name() const { return detail::instance_name(name, result.param_index); }
+    };
+
+    /**
+     * @struct BenchmarkEndEvent
+     * @brief Reported when a benchmark, or one thread count of a multi-threaded benchmark, has finished
+     * @details Benchmark runs report the same run, suite and test start
+     *          events as test runs, then this event in place of TestEndEvent.
+     *          The statistics are per iteration, in nanoseconds for the time
+     *          metric, and zero when the benchmark failed.
+     */
+    struct BenchmarkEndEvent {
+        std::string_view suite{};
+        std::string_view name{};        ///< Including the `/threads:N` suffix of multi-threaded runs
+        TestResult result{};            ///< Failures recorded or thrown by the benchmark body
+        std::chrono::steady_clock::duration duration{};     ///< Run time including calibration, without timer overhead
+        BenchmarkMetric metric{};
+        std::size_t iterations{};       ///< Calibrated iterations per sample
+        std::size_t sample_count{};
+        double mean{};
+        double median{};
+        double stddev{};
+        double min{};
+        double max{};
+        std::vector<std::string> notes{};   ///< Baseline comparison, latencies, counters and thread scaling, as lines of the text output
+    };
+
+    /**
+     * @struct SuiteEndEvent
+     * @brief Reported after the last test of a suite
+     */
+    struct SuiteEndEvent {
+        std::string_view suite{};
+        std::size_t test_count{};       ///< Tests reported for the suite, counting each parameter instance
+        std::chrono::steady_clock::duration duration{};     ///< From the first test begin to the last test end
+    };
+
+    /**
+     * @struct RunEndEvent
+     * @brief Reported once after the last test of a run
+     */
+    struct RunEndEvent {
+        std::size_t test_count{};               ///< Tests reported, counting each parameter instance
+        std::size_t suite_count{};
+        std::size_t passed{};                   ///< Number of passed tests
+        std::vector<std::string> failures{};    ///< "Suite.Case" names of failed tests
+        std::chrono::steady_clock::duration duration{};     ///< Wall time of the run
+        bool aborted{ false };                  ///< The run was stopped by an assertion failure
+        std::vector<std::pair<std::string, double>> regressions{};  ///< Benchmarks slower than the baseline beyond the threshold, with their change in percent
+        double regression_threshold{};          ///< `RunOptions::benchmark_threshold` of the regressions
+    };
+
+    /**
+     * @class Reporter
+     * @brief Receives the progress events of a test run
+     * @details Register implementations with get_reporters(). All events of a
+     *          run are delivered in order from a single thread, which is not
+     *          the thread running the tests unless `RunOptions::async_output`
+     *          is disabled or tests run in worker processes. The string views of an event stay valid until
+     *          start() returns. Exceptions thrown by a reporter are printed to
+     *          stderr and do not affect the run.
+     */
+    class Reporter {
+    public:
+        virtual ~Reporter() = default;
+
+        virtual void on_run_start([[maybe_unused]] const RunStartEvent& event) {}
+        virtual void on_suite_start([[maybe_unused]] const SuiteStartEvent& event) {}
+        virtual void on_test_start([[maybe_unused]] const TestStartEvent& event) {}
+
+        /**
+         * @brief Called for each recorded failure of a test, right before on_test_end()
+         * @param test The finished test
+         * @param failure One entry of `test.result.failures`
+         */
+        virtual void on_failure([[maybe_unused]] const TestEndEvent& test, [[maybe_unused]] const Failure& failure) {}
+
+        virtual void on_test_end([[maybe_unused]] const TestEndEvent& event) {}
+
+        /// Called in benchmark runs in place of on_test_end(), without on_failure() calls
+        virtual void on_benchmark_end([[maybe_unused]] const BenchmarkEndEvent& event) {}
+
+        virtual void on_suite_end([[maybe_unused]] const SuiteEndEvent& event) {}
+        virtual void on_run_end([[maybe_unused]] const RunEndEvent& event) {}
+    };
+
+    /**
+     * @class TextReporter
+     * @brief The default reporter, printing GTest-compatible text to stdout
+     */
+    class TextReporter final : public Reporter {
+    public:
+        /**
+         * @brief Construct a text reporter
+         * @param unit Unit of printed durations
+         */
+        explicit TextReporter(const TimeUnit unit = TimeUnit::Milliseconds) noexcept : m_unit(unit) {}
+
+        void on_run_start(const RunStartEvent& event) override {
+            m_noun = event.benchmarks ? "benchmark" : "test";
+            std::println( "[==========] Running {} {}{} from {} {} suite{}.", 
+                event.test_count, m_noun, event.test_count > 1 ? "s" : "", event.suite_count, m_noun, event.suite_count > 1 ? "s" : ""
+            );
+            // Benchmarks have no global environments
+            if (!event.benchmarks) std::println("[----------] Global test environment set-up.");
+        }
+
+        void on_suite_start(const SuiteStartEvent& event) override {
+            std::println( "[----------] {} {}{} from {}", 
+                event.test_count, m_noun, event.test_count > 1 ? "s" : "", event.suite
+            );
+        }
+
+        void on_test_start(const TestStartEvent& event) override {
+            std::println("[ RUN      ] {}.{}", event.suite, event.full_name());
+        }
+
+        void on_test_end(const TestEndEvent& event) override {
+            using Outcome = TestResult::Outcome;
+            const auto& result = event.result;
+            const auto time = detail::format_duration(event.duration, m_unit);
+            const auto name = event.full_name();
+            switch (result.outcome) {
+            case Outcome::Passed:
+                std::println("[       OK ] {}.{}  ({})", event.suite, name, time);
+                print_counters(result.counters);
+                return;
+            case Outcome::Assert:
+                std::println("[  ASSERT  ] {}.{}  ({})", event.suite, name, time);
+                break;
+            case Outcome::Expect:
+                std::println("[  EXPECT  ] {}.{}  ({})", event.suite, name, time);
+                break;
+            case Outcome::Unknown:
+                std::println("[ UNKNOWN  ] {}.{}  ({})", event.suite, name, time);
+                break;
+            case Outcome::Crashed:
+                std::println("[  CRASH   ] {}.{}  ({})", event.suite, name, time);
+                break;
+            case Outcome::Timeout:
+                std::println("[ TIMEOUT  ] {}.{}  ({})", event.suite, name, time);
+                break;
+            }
+            for (const auto& failure : result.failures) {
+                if (failure.file.empty()) {
+                    std::println("[  FAILED  ] {}", failure.message);
+                } else {
+                    std::println("[  FAILED  ] {}:{}: {}", failure.file, failure.line, failure.message);
+                }
+            }
+            if (result.dropped_failures > 0) {
+                std::println("[  FAILED  ] ... {} more failure{} not shown",
+                    result.dropped_failures, result.dropped_failures > 1 ? "s" : "");
+            }
+            print_counters(result.counters);
+        }
+
+        void on_benchmark_end(const BenchmarkEndEvent& event) override {
+            if (event.result.outcome != TestResult::Outcome::Passed) {
+                on_test_end({ event.suite, event.name, event.result, event.duration });
+            } else {
+                const auto metric = [&](const double value) { return detail::format_metric(value, event.metric); };
+                std::println("[     DONE ] {}.{}  (mean {}, median {}, stddev {}, min {}, max {}{}; {} iterations x {})",
+                    event.suite, event.name,
+                    metric(event.mean), metric(event.median), metric(event.stddev), metric(event.min), metric(event.max),
+                    event.metric == BenchmarkMetric::Time ? "" : std::format(" {}", detail::metric_name(event.metric)),
+                    event.iterations, event.sample_count
+                );
+            }
+            for (const auto& note : event.notes) std::println("{}", note);
+        }
+
+        void on_suite_end(const SuiteEndEvent& event) override {
+            std::println( "[----------] {} {}{} from {} ({} total)", 
+                event.test_count, m_noun, event.test_count != 1 ? "s" : "", event.suite,
+                detail::format_duration(event.duration, m_unit)
+            );
+            std::println("");
+        }
+
+        void on_run_end(const RunEndEvent& event) override {
+            // An assertion failure ends the output right after the failed test
+            if (event.aborted) return;
+
+            const bool benchmarks = m_noun == "benchmark";
+            if (!benchmarks) std::println("[----------] Global test environment tear-down");
+            std::println(
+                "[==========] {} {}{} from {} {} suite{} ran. ({} total)", 
+                event.test_count, m_noun, event.test_count != 1 ? "s" : "",
+                event.suite_count, m_noun, event.suite_count != 1 ? "s" : "",
+                detail::format_duration(event.duration, m_unit)
+            );
+
+            // Print pass/fail statistics
+            std::println("[  PASSED  ] {} {}{}.", event.passed, m_noun, event.passed > 1 ? "s" : "");
+
+            // Print detailed failure list if any tests failed
+            if (!event.failures.empty()) {
+                std::println("[  FAILED  ] {} {}{}, listed below:", event.failures.size(), m_noun, event.failures.size() > 1 ? "s" : "");
+                for (const auto& test_name : event.failures) {
+                    std::println("[  FAILED  ] {}", test_name);
+                }
+                std::println("");
+                std::println("{} FAILED {}{}", event.failures.size(), benchmarks ? "BENCHMARK" : "TEST", event.failures.size() > 1 ? "S" : "");
+            }
+            if (!event.regressions.empty()) {
+                std::println("[ SLOWER   ] {} benchmark{} significantly slower than the baseline by more than {}%, listed below:",
+                    event.regressions.size(), event.regressions.size() > 1 ? "s" : "", event.regression_threshold);
+                for (const auto& [name, change] : event.regressions) {
+                    std::println("[ SLOWER   ] {}  ({:+.2f}%)", name, change);
+                }
+            }
+        }
+
+    private:
+        /// e.g. "[ COUNTERS ] 1204711 instructions, 431276 cycles, 52 cache-misses, 117 branch-misses"
+        static void print_counters(const std::vector<CounterValue>& counters) {
+            if (counters.empty()) return;
+            std::string line = "[ COUNTERS ]";
+            for (std::size_t i = 0; i < counters.size(); ++i) {
+                std::format_to(std::back_inserter(line), "{} {} {}",
+                    i == 0 ? "" : ",", counters[i].value, counter_name(counters[i].counter));
+            }
+            std::println("{}", line);
+        }
+
+        TimeUnit m_unit;
+        std::string_view m_noun{ "test" };  ///< "benchmark" in benchmark runs
+    };
+
+    /**
+     * @class JUnitXmlReporter
+     * @brief Streams results as a JUnit XML file (`--output=xml:PATH`)
+     * @details Every finished test is appended and flushed together with the
+     *          closing tags, so the file is always well-formed and holds all
+     *          tests reported so far. Counts only known at the end of a suite
+     *          or run, including the number of parameter instances, are
+     *          written into a space-padded area reserved in the opening tag.
+     */
+    class JUnitXmlReporter final : public Reporter {
+    public:
+        /**
+         * @brief Create or truncate the result file
+         * @param path Path of the XML file
+         */
+        explicit JUnitXmlReporter(const std::string& path) : m_document(path) {}
+
+        /// Whether the file could be opened for writing
+        bool is_open() const { return m_document.is_open(); }
+
+        void on_run_start([[maybe_unused]] const RunStartEvent& event) override {
+            m_document.append(std::format(
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<testsuites name=\"AllTests\""
+            ), "");
+            m_run_attributes = m_document.position();
+            m_document.append(std::format("{:{}}>\n", "", reserved_width), trailer());
+        }
+
+        void on_suite_start(const SuiteStartEvent& event) override {
+            m_document.append(std::format(
+                "  <testsuite name=\"{}\"", detail::escape_xml(event.suite)
+            ), "");
+            m_suite_attributes = m_document.position();
+            m_suite_open = true;
+            m_suite_tests = m_suite_failures = m_suite_errors = 0;
+            m_document.append(std::format("{:{}}>\n", "", reserved_width), trailer());
+        }
+
+        void on_test_end(const TestEndEvent& event) override {
+            using Outcome = TestResult::Outcome;
+            const auto& result = event.result;
+            std::string content = std::format(
+                "    <testcase name=\"{}\" classname=\"{}\" status=\"{}\" time=\"{:.6f}\"",
+                detail::escape_xml(event.full_name()), detail::escape_xml(event.suite),
+                detail::outcome_name(result.outcome), detail::to_seconds(event.duration)
+            );
+            ++m_suite_tests;
+            ++m_run_tests;
+            if (result.outcome == Outcome::Passed && result.counters.empty()) {
+                content += "/>\n";
+            } else if (result.outcome == Outcome::Passed) {
+                content += ">\n" + properties(result.counters) + "    </testcase>\n";
+            } else {
+                // Failed checks are failures, anything that escaped the checks is an error
+                const bool failure = result.outcome == Outcome::Assert || result.outcome == Outcome::Expect;
+                const std::string_view element = failure ? "failure" : "error";
+                ++(failure ? m_suite_failures : m_suite_errors);
+                ++(failure ? m_run_failures : m_run_errors);
+
+                content += ">\n";
+                for (const auto& f : result.failures) {
+                    content += std::format("      <{} message=\"{}\" type=\"{}\">", element,
+                        detail::escape_xml(f.message), detail::outcome_name(result.outcome));
+                    if (!f.file.empty()) content += std::format("{}:{}\n", detail::escape_xml(f.file), f.line);
+                    content += std::format("{}</{}>\n", detail::escape_xml(f.message), element);
+                }
+                if (result.dropped_failures > 0) {
+                    content += std::format("      <{0} message=\"{1} more failures not recorded\" type=\"{2}\"/>\n",
+                        element, result.dropped_failures, detail::outcome_name(result.outcome));
+                }
+                if (result.failures.empty() && result.dropped_failures == 0) {
+                    content += std::format("      <{} message=\"{}\" type=\"{}\"/>\n",
+                        element, detail::outcome_name(result.outcome), detail::outcome_name(result.outcome));
+                }
+                content += properties(result.counters) + "    </testcase>\n";
+            }
+            m_document.append(content, trailer());
+        }
+
+        void on_benchmark_end(const BenchmarkEndEvent& event) override {
+            if (event.result.outcome != TestResult::Outcome::Passed) {
+                on_test_end({ event.suite, event.name, event.result, event.duration });
+                return;
+            }
+            ++m_suite_tests;
+            ++m_run_tests;
+            std::string content = std::format(
+                "    <testcase name=\"{}\" classname=\"{}\" status=\"{}\" time=\"{:.6f}\">\n      <properties>\n",
+                detail::escape_xml(event.name), detail::escape_xml(event.suite),
+                detail::outcome_name(event.result.outcome), detail::to_seconds(event.duration)
+            );
+            content += std::format("        <property name=\"metric\" value=\"{}\"/>\n", detail::metric_name(event.metric));
+            content += std::format("        <property name=\"iterations\" value=\"{}\"/>\n", event.iterations);
+            content += std::format("        <property name=\"samples\" value=\"{}\"/>\n", event.sample_count);
+            for (const auto& [name, value] : { std::pair{ "mean", event.mean }, { "median", event.median },
+                    { "stddev", event.stddev }, { "min", event.min }, { "max", event.max } }) {
+                content += std::format("        <property name=\"{}\" value=\"{:.9g}\"/>\n", name, value);
+            }
+            content += "      </properties>\n";
+            if (!event.notes.empty()) {
+                content += "      <system-out>";
+                for (const auto& note : event.notes) content += detail::escape_xml(note) + "\n";
+                content += "</system-out>\n";
+            }
+            m_document.append(content + "    </testcase>\n", trailer());
+        }
+
+        void on_suite_end(const SuiteEndEvent& event) override {
+            m_document.patch(m_suite_attributes, attributes(m_suite_tests, m_suite_failures, m_suite_errors, event.duration));
+            m_suite_open = false;
+            m_document.append("  </testsuite>\n", trailer());
+        }
+
+        void on_run_end(const RunEndEvent& event) override {
+            // A run stopped by an assertion failure does not end its suite
+            if (m_suite_open) {
+                m_document.patch(m_suite_attributes, attributes(m_suite_tests, m_suite_failures, m_suite_errors, {}));
+                m_suite_open = false;
+                m_document.append("  </testsuite>\n", trailer());
+            }
+            m_document.patch(m_run_attributes, attributes(m_run_tests, m_run_failures, m_run_errors, event.duration));
+        }
+
+    private:
+        /// Longest decimal count
+        static constexpr std::size_t count_width = std::numeric_limits<std::size_t>::digits10 + 1;
+
+        /// Longest time in seconds with 6 decimals: sign, the digits of the nanoseconds and the point
+        static constexpr std::size_t time_width = std::numeric_limits<std::chrono::steady_clock::rep>::digits10 + 3;
+
+        /// Width of the attribute area reserved in opening tags, enough for the longest attributes
+        static constexpr std::size_t reserved_width =
+            std::string_view{ R"( tests="" failures="" errors="" time="")" }.size() + 3 * count_width + time_width;
+
+        std::string trailer() const {
+            return m_suite_open ? "  </testsuite>\n</testsuites>\n" : "</testsuites>\n";
+        }
+
+        /// Performance counters as `<properties>` of a test case, empty without counters
+        static std::string properties(const std::vector<CounterValue>& counters) {
+            if (counters.empty()) return {};
+            std::string text = "      <properties>\n";
+            for (const auto& counter : counters) {
+                text += std::format("        <property name=\"{}\" value=\"{}\"/>\n", counter_name(counter.counter), counter.value);
+            }
+            return text + "      </properties>\n";
+        }
+
+        static std::string attributes(
+            const std::size_t tests, const std::size_t failures, const std::size_t errors, const std::chrono::steady_clock::duration time
+        ) {
+            auto text = std::format(" tests=\"{}\" failures=\"{}\" errors=\"{}\" time=\"{:.6f}\"",
+                tests, failures, errors, detail::to_seconds(time));
+            text.resize(std::max(text.size(), reserved_width), ' ');
+            return text;
+        }
+
+        detail::StreamingDocument m_document;
+        std::streamoff m_run_attributes{};
+        std::streamoff m_suite_attributes{};
+        bool m_suite_open{ false };
+        std::size_t m_suite_tests{}, m_suite_failures{}, m_suite_errors{};
+        std::size_t m_run_tests{}, m_run_failures{}, m_run_errors{};
+    };
+
+    /**
+     * @class JsonReporter
+     * @brief Streams results as a JSON file (`--output=json:PATH`)
+     * @details The document holds one line per finished test in its
+     *          "tests" array and the run summary at the end. Like
+     *          JUnitXmlReporter, it is rewritten with its closing brackets
+     *          after every test, so an interrupted run leaves valid JSON.
+     */
+    class JsonReporter final : public Reporter {
+    public:
+        /**
+         * @brief Create or truncate the result file
+         * @param path Path of the JSON file
+         */
+        explicit JsonReporter(const std::string& path) : m_document(path) {}
+
+        /// Whether the file could be opened for writing
+        bool is_open() const { return m_document.is_open(); }
+
+        void on_run_start(const RunStartEvent& event) override {
+            m_document.append(std::format(
+                "{{\n\"test_count\": {},\n\"suite_count\": {},\n\"tests\": [", event.test_count, event.suite_count
+            ), "\n]\n}\n");
+        }
+
+        void on_test_end(const TestEndEvent& event) override {
+            append_test(event, "");
+        }
+
+        void on_benchmark_end(const BenchmarkEndEvent& event) override {
+            std::string benchmark = std::format(
+                ", \"benchmark\": {{\"metric\": \"{}\", \"iterations\": {}, \"samples\": {}, "
+                "\"mean\": {:.9g}, \"median\": {:.9g}, \"stddev\": {:.9g}, \"min\": {:.9g}, \"max\": {:.9g}, \"notes\": [",
+                detail::metric_name(event.metric), event.iterations, event.sample_count,
+                event.mean, event.median, event.stddev, event.min, event.max
+            );
+            for (std::size_t i = 0; i < event.notes.size(); ++i) {
+                benchmark += std::format("{}\"{}\"", i == 0 ? "" : ", ", detail::escape_json(event.notes[i]));
+            }
+            append_test({ event.suite, event.name, event.result, event.duration }, benchmark + "]}");
+        }
+
+        void on_run_end(const RunEndEvent& event) override {
+            std::string content = std::format(
+                "\n],\n\"tests_run\": {},\n\"passed\": {},\n\"time\": {:.6f},\n\"aborted\": {},\n\"failed\": [",
+                event.test_count, event.passed, detail::to_seconds(event.duration), event.aborted
+            );
+            for (std::size_t i = 0; i < event.failures.size(); ++i) {
+                content += std::format("{}\"{}\"", i == 0 ? "" : ", ", detail::escape_json(event.failures[i]));
+            }
+            m_document.append(content + "]\n}\n", "");
+        }
+
+    private:
+        /// Append the entry of a finished test, with `extra` members after the common ones
+        void append_test(const TestEndEvent& event, const std::string_view extra) {
+            const auto& result = event.result;
+            std::string content = std::format(
+                "{}\n{{\"suite\": \"{}\", \"name\": \"{}\", \"status\": \"{}\", \"time\": {:.6f}, \"failures\": [",
+                m_first_test ? "" : ",", detail::escape_json(event.suite), detail::escape_json(event.full_name()),
+                detail::outcome_name(result.outcome), detail::to_seconds(event.duration)
+            );
+            for (std::size_t i = 0; i < result.failures.size(); ++i) {
+                const auto& f = result.failures[i];
+                content += std::format("{}{{\"message\": \"{}\", \"file\": \"{}\", \"line\": {}}}",
+                    i == 0 ? "" : ", ", detail::escape_json(f.message), detail::escape_json(f.file), f.line);
+            }
+            content += std::format("], \"dropped_failures\": {}", result.dropped_failures);
+            if (!result.counters.empty()) {
+                content += ", \"counters\": {";
+                for (std::size_t i = 0; i < result.counters.size(); ++i) {
+                    content += std::format("{}\"{}\": {}", i == 0 ? "" : ", ",
+                        counter_name(result.counters[i].counter), result.counters[i].value);
+                }
+                content += "}";
+            }
+            content += extra;
+            content += "}";
+            m_first_test = false;
+            m_document.append(content, "\n]\n}\n");
+        }
+
+        detail::StreamingDocument m_document;
+        bool m_first_test{ true };
+    };
+
+    /**
+     * @brief Get the reporters notified by every test run
+     * @return Reference to the reporter list
+     * @details Reporters added here receive the events of start() in
+     *          addition to the default TextReporter (see
+     *          `RunOptions::text_output`). They must stay registered until
+     *          start() returns.
+     */
+    std::vector<std::unique_ptr<Reporter>>& get_reporters() {
+        static std::vector<std::unique_ptr<Reporter>> reporters;
+        return reporters;
+    }
+
+}
+
+
+namespace vct::test::unit::detail {
+
+    /// Marks the end of the event stream for the reporter thread
+    struct StopEvent {};
+
+    using Event = std::variant<
+        StopEvent, RunStartEvent, SuiteStartEvent, TestStartEvent, TestEndEvent, BenchmarkEndEvent, SuiteEndEvent, RunEndEvent
+    >;
+
+    /**
+     * @class EventDispatcher
+     * @brief Delivers the events of a run to its reporters
+     * @details In asynchronous mode, events are passed through a bounded
+     *          single-producer/single-consumer ring buffer to a background
+     *          thread calling the reporters, so the thread running the tests
+     *          never blocks on output unless the buffer is full. Only the
+     *          thread calling start() posts events; flush() may be called from
+     *          any thread. In synchronous mode, post() calls the reporters
+     *          directly.
+     */
+    class EventDispatcher {
+    public:
+        /// Ring buffer capacity, a power of two
+        static constexpr std::size_t capacity = 1024;
+
+        /**
+         * @param reporters Reporters to notify, they must outlive the dispatcher
+         * @param async Deliver events on a background thread
+         */
+        EventDispatcher(std::vector<Reporter*> reporters, const bool async)
+            : m_reporters(std::move(reporters)) {
+            if (async) {
+                m_slots.resize(capacity);
+                m_thread = std::thread{ [this] { consume(); } };
+            }
+        }
+
+        EventDispatcher(const EventDispatcher&) = delete;
+        EventDispatcher& operator=(const EventDispatcher&) = delete;
+
+        /// Delivers all posted events, then stops the reporter thread
+        ~EventDispatcher() {
+            if (!m_thread.joinable()) return;
+            post(StopEvent{});
+            m_thread.join();
+        }
+
+        /**
+         * @brief Queue an event, waiting only while the buffer is full
+         * @param event The event
+         */
+        void post(Event event) {
+            if (!m_thread.joinable()) {
+                deliver(event);
+                return;
+            }
+            const auto head = m_head.load(std::memory_order_relaxed);
+            auto tail = m_tail.load(std::memory_order_acquire);
+            while (head - tail == capacity) {
+                m_tail.wait(tail, std::memory_order_acquire);
+                tail = m_tail.load(std::memory_order_acquire);
+            }
+            m_slots[head % capacity] = std::move(event);
+            m_head.store(head + 1, std::memory_order_release);
+            m_head.notify_one();
+        }
+
+        /// Wait until all events posted so far have been delivered
+        void flush() {
+            if (!m_thread.joinable()) return;
+            const auto target = m_head.load(std::memory_order_acquire);
+            auto tail = m_tail.load(std::memory_order_acquire);
+            while (tail < target) {
+                m_tail.wait(tail, std::memory_order_acquire);
+                tail = m_tail.load(std::memory_order_acquire);
+            }
+        }
+
+    private:
+        void consume() {
+            auto tail = m_tail.load(std::memory_order_relaxed);
+            while (true) {
+                auto head = m_head.load(std::memory_order_acquire);
+                while (head == tail) {
+                    m_head.wait(head, std::memory_order_acquire);
+                    head = m_head.load(std::memory_order_acquire);
+                }
+                for (; tail != head; ++tail) {
+                    auto& slot = m_slots[tail % capacity];
+                    const bool stop = std::holds_alternative<StopEvent>(slot);
+                    if (!stop) deliver(slot);
+                    // Release the strings and failures of the event before handing the slot back
+                    slot = StopEvent{};
+                    m_tail.store(tail + 1, std::memory_order_release);
+                    m_tail.notify_all();
+                    if (stop) return;
+                }
+            }
+        }
+
+        void deliver(const Event& event) {
+            for (Reporter* reporter : m_reporters) {
+                try {
+                    std::visit([&]<typename T>(const T& e) {
+                        if constexpr (std::same_as<T, RunStartEvent>) reporter->on_run_start(e);
+                        else if constexpr (std::same_as<T, SuiteStartEvent>) reporter->on_suite_start(e);
+                        else if constexpr (std::same_as<T, TestStartEvent>) reporter->on_test_start(e);
+                        else if constexpr (std::same_as<T, TestEndEvent>) {
+                            for (const auto& failure : e.result.failures) reporter->on_failure(e, failure);
+                            reporter->on_test_end(e);
+                        }
+                        else if constexpr (std::same_as<T, BenchmarkEndEvent>) reporter->on_benchmark_end(e);
+                        else if constexpr (std::same_as<T, SuiteEndEvent>) reporter->on_suite_end(e);
+                        else if constexpr (std::same_as<T, RunEndEvent>) reporter->on_run_end(e);
+                    }, event);
+                } catch (const std::exception& e) {
+                    std::println(std::cerr, "[  ERROR   ] Reporter failed: {}", e.what());
+                } catch (...) {
+                    std::println(std::cerr, "[  ERROR   ] Reporter failed with an unknown exception");
+                }
+            }
+        }
+
+        std::vector<Reporter*> m_reporters;
+        std::vector<Event> m_slots;
+        alignas(64) std::atomic<std::size_t> m_head{};   ///< Next slot to write, only advanced by the producer
+        alignas(64) std::atomic<std::size_t> m_tail{};   ///< Next slot to read, only advanced by the consumer
+        std::thread m_thread;
+    };
+
+    /**
+     * @brief Open the result files requested with `--output`
+     * @param outputs Result files as "xml:PATH" or "json:PATH"
+     * @return One reporter per file, or nullopt once a file cannot be written
+     */
+    std::optional<std::vector<std::unique_ptr<Reporter>>> open_output_reporters(const std::vector<std::string>& outputs) {
+        std::vector<std::unique_ptr<Reporter>> reporters;
+        for (const auto& output : outputs) {
+            const auto open = [&]<typename T>(const std::string_view path) {
+                auto reporter = std::make_unique<T>(std::string{ path });
+                const bool is_open = reporter->is_open();
+                if (is_open) reporters.push_back(std::move(reporter));
+                return is_open;
+            };
+            const std::string_view spec = output;
+            const bool opened =
+                spec.starts_with("xml:") ? open.template operator()<JUnitXmlReporter>(spec.substr(4)) :
+                spec.starts_with("json:") ? open.template operator()<JsonReporter>(spec.substr(5)) :
+                false;
+            if (!opened) {
+                std::println("[  ERROR   ] Cannot write output '{}', expected xml:PATH or json:PATH", output);
+                return std::nullopt;
+            }
+        }
+        return reporters;
+    }
+
+
+    /**
+     * @class WorkStealingPool
+     * @brief Fixed-size thread pool distributing a static set of task indices
+     * @details Task indices are split into contiguous blocks, one per worker.
+     *          Each worker pops from the back of its own queue and, once empty,
+     *          steals from the front of the other workers' queues, so that a
+     *          few slow tests do not leave the remaining workers idle.
+     */
+    class WorkStealingPool {
+    public:
+        /**
+         * @brief Create the pool and distribute task indices [0, task_count)
+         * @param worker_count Number of worker threads (at least 1)
+         * @param task_count Number of tasks to execute
+         */
+        WorkStealingPool(const std::size_t worker_count, const std::size_t task_count)
+            : m_queues(std::max<std::size_t>(worker_count, 1)) {
+            const std::size_t workers = m_queues.size();
+            for (std::size_t w = 0; w < workers; ++w) {
+                const std::size_t first = task_count * w / workers;
+                const std::size_t last = task_count * (w + 1) / workers;
+                // Reverse order so that pop_back() yields tasks in registry order
+                for (std::size_t i = last; i > first; --i) {
+                    m_queues[w].tasks.push_back(i - 1);
+                }
+            }
+        }
+
+        WorkStealingPool(const WorkStealingPool&) = delete;
+        WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+        ~WorkStealingPool() { join(); }
+
+        /**
+         * @brief Start the worker threads
+         * @param task Callable invoked as task(index) for each task index
+         * @param on_exit Callable invoked by each worker once it runs out of work
+         */
+        template<typename Task, typename Exit>
+        void launch(Task task, Exit on_exit) {
+            for (std::size_t w = 0; w < m_queues.size(); ++w) {
+                m_threads.emplace_back([this, w, task, on_exit] {
+                    while (!m_stop.load(std::memory_order_relaxed)) {
+                        const auto index = next(w);
+                        if (!index) break;
+                        task(*index);
+                    }
+                    on_exit();
+                });
+            }
+        }
+
+        /**
+         * @brief Ask all workers to stop picking up new tasks
+         */
+        void request_stop() noexcept { m_stop.store(true, std::memory_order_relaxed); }
+
+        /**
+         * @brief Wait for all worker threads to finish
+         */
+        void join() {
+            for (auto& thread : m_threads) {
+                if (thread.joinable()) thread.join();
+            }
+            m_threads.clear();
+        }
+
+        /**
+         * @brief Number of worker threads
+         */
+        std::size_t size() const noexcept { return m_queues.size(); }
+
+    private:
+        struct alignas(64) Queue {
+            std::mutex mutex;
+            std::deque<std::size_t> tasks;
+        };
+
+        std::optional<std::size_t> next(const std::size_t self) {
+            {
+                auto& own = m_queues[self];
+                std::lock_guard lock{ own.mutex };
+                if (!own.tasks.empty()) {
+                    const std::size_t index = own.tasks.back();
+                    own.tasks.pop_back();
+                    return index;
+                }
+            }
+            for (std::size_t offset = 1; offset < m_queues.size(); ++offset) {
+                auto& victim = m_queues[(self + offset) % m_queues.size()];
+                std::lock_guard lock{ victim.mutex };
+                if (!victim.tasks.empty()) {
+                    const std::size_t index = victim.tasks.front();
+                    victim.tasks.pop_front();
+                    return index;
+                }
+            }
+            return std::nullopt;
+        }
+
+        std::vector<Queue> m_queues;
+        std::vector<std::thread> m_threads;
+        std::atomic<bool> m_stop{ false };
+    };
+
+#if defined(_M_VCT_TEST_UNIT_POSIX)
+
+    /**
+     * @brief Write a whole buffer to a file descriptor, retrying on EINTR and short writes
+     * @return false if the descriptor was closed or failed
+     */
+    bool write_all(const int fd, const void* data, std::size_t size) noexcept {
+        auto* bytes = static_cast<const char*>(data);
+        while (size > 0) {
+            const auto written = ::write(fd, bytes, size);
+            if (written < 0 && errno == EINTR) continue;
+            if (written <= 0) return false;
+            bytes += written;
+            size -= static_cast<std::size_t>(written);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Read exactly `size` bytes from a file descriptor, retrying on EINTR
+     * @return false on end of file or error
+     */
+    bool read_all(const int fd, void* data, std::size_t size) noexcept {
+        auto* bytes = static_cast<char*>(data);
+        while (size > 0) {
+            const auto got = ::read(fd, bytes, size);
+            if (got < 0 && errno == EINTR) continue;
+            if (got <= 0) return false;
+            bytes += got;
+            size -= static_cast<std::size_t>(got);
+        }
+        return true;
+    }
+
+    /// Parameter index field of a result frame for results without one
+    constexpr std::uint64_t no_param_index = std::numeric_limits<std::uint64_t>::max();
+
+    /// Set in the index of a frame carrying the TearDownTestSuite() outcome of the suite of the indexed test
+    constexpr std::uint64_t suite_tear_down_flag = std::uint64_t{ 1 } << 63;
+
+    /**
+     * @brief Encode a test result as a frame sent from a worker process to the runner
+     * @details Layout: index, payload size, then outcome, begin/end ticks of the
+     *          (system-wide) steady clock, parameter index (all ones if none),
+     *          dropped failure count, the failures as length-prefixed
+     *          strings and the performance counters. Both ends are the same executable, so native byte order
+     *          and sizes are used. A test sends one such frame per result,
+     *          followed by an empty frame (see encode_done()).
+     */
+    std::string encode_result(const std::uint64_t index, const TestResult& result) {
+        std::string payload;
+        const auto put = [&](const auto value) {
+            payload.append(reinterpret_cast<const char*>(&value), sizeof(value));
+        };
+        const auto put_string = [&](const std::string_view text) {
+            put(static_cast<std::uint64_t>(text.size()));
+            payload.append(text);
+        };
+
+        put(static_cast<std::uint8_t>(result.outcome));
+        put(static_cast<std::int64_t>(result.begin.time_since_epoch().count()));
+        put(static_cast<std::int64_t>(result.end.time_since_epoch().count()));
+        put(result.param_index ? static_cast<std::uint64_t>(*result.param_index) : no_param_index);
+        put(static_cast<std::uint64_t>(result.dropped_failures));
+        put(static_cast<std::uint64_t>(result.failures.size()));
+        for (const auto& failure : result.failures) {
+            put_string(failure.message);
+            put_string(failure.file);
+            put(static_cast<std::uint32_t>(failure.line));
+        }
+        put(static_cast<std::uint64_t>(result.counters.size()));
+        for (const auto& counter : result.counters) {
+            put(static_cast<std::uint8_t>(counter.counter));
+            put(counter.value);
+        }
+
+        std::string frame;
+        frame.append(reinterpret_cast<const char*>(&index), sizeof(index));
+        const auto size = static_cast<std::uint64_t>(payload.size());
+        frame.append(reinterpret_cast<const char*>(&size), sizeof(size));
+        frame += payload;
+        return frame;
+    }
+
+    /**
+     * @brief Encode the frame telling the runner that a test has sent all of its results
+     * @details An empty payload, which no encoded result has.
+     */
+    std::string encode_done(const std::uint64_t index) {
+        std::string frame;
+        frame.append(reinterpret_cast<const char*>(&index), sizeof(index));
+        const std::uint64_t size = 0;
+        frame.append(reinterpret_cast<const char*>(&size), sizeof(size));
+        return frame;
+    }
+
+    /**
+     * @brief Decode the payload of a frame produced by encode_result()
+     * @return The result, or std::nullopt if the payload is malformed
+     */
+    std::optional<TestResult> decode_result(std::string_view payload) {
+        bool ok = true;
+        const auto get = [&]<typename T>(T& value) {
+            if (payload.size() < sizeof(T)) { ok = false; return; }
+            std::memcpy(&value, payload.data(), sizeof(T));
+            payload.remove_prefix(sizeof(T));
+        };
+        const auto get_string = [&](std::string& text) {
+            std::uint64_t size{};
+            get(size);
+            if (!ok || payload.size() < size) { ok = false; return; }
+            text.assign(payload.substr(0, size));
+            payload.remove_prefix(size);
+        };
+
+        TestResult result;
+        std::uint8_t outcome{};
+        std::int64_t begin{}, end{};
+        std::uint64_t param_index{}, dropped{}, count{};
+        get(outcome);
+        get(begin);
+        get(end);
+        get(param_index);
+        get(dropped);
+        get(count);
+        if (!ok || outcome > static_cast<std::uint8_t>(TestResult::Outcome::Timeout)) return std::nullopt;
+
+        result.outcome = static_cast<TestResult::Outcome>(outcome);
+        result.begin = clock::time_point{ clock::duration{ begin } };
+        result.end = clock::time_point{ clock::duration{ end } };
+        if (param_index != no_param_index) result.param_index = static_cast<std::size_t>(param_index);
+        result.dropped_failures = static_cast<std::size_t>(dropped);
+        for (std::uint64_t i = 0; i < count && ok; ++i) {
+            Failure failure;
+            std::uint32_t line{};
+            get_string(failure.message);
+            get_string(failure.file);
+            get(line);
+            failure.line = line;
+            result.failures.push_back(std::move(failure));
+        }
+        get(count);
+        for (std::uint64_t i = 0; i < count && ok; ++i) {
+            std::uint8_t counter{};
+            CounterValue value;
+            get(counter);
+            get(value.value);
+            if (counter > static_cast<std::uint8_t>(PerfCounter::ContextSwitches)) ok = false;
+            value.counter = static_cast<PerfCounter>(counter);
+            result.counters.push_back(value);
+        }
+        if (!ok) return std::nullopt;
+        return result;
+    }
+
+    /**
+     * @brief Describe how a worker process terminated
+     * @param status Status returned by waitpid()
+     */
+    std::string describe_exit(const int status) {
+        if (WIFSIGNALED(status)) {
+            const int sig = WTERMSIG(status);
+            const char* name = ::strsignal(sig);
+            return std::format("worker process terminated by signal {} ({})", sig, name ? name : "unknown");
+        }
+        if (WIFEXITED(status)) {
+            return std::format("worker process exited with status {}", WEXITSTATUS(status));
+        }
+        return "worker process terminated abnormally";
+    }
+
+    /// Signal used to request the stack trace of a hung test
+    constexpr int stack_trace_signal = SIGUSR2;
+
+    /// Time a hung worker process is given to print its stack trace before it is killed
+    constexpr std::chrono::milliseconds stack_trace_grace{ 200 };
+
+    /// Frames kept of a stack trace, including the signal handler itself
+    constexpr int max_stack_frames = 64;
+
+    /// Stack trace captured by capture_stack_handler(), symbolized by the thread that requested it
+    std::array<void*, max_stack_frames> captured_frames{};
+    int captured_frame_count{};
+    std::atomic<bool> captured_stack_ready{ false };
+
+    /// First line written by print_stack_handler(), formatted before the handler is installed
+    std::array<char, 80> stack_header{};
+    std::size_t stack_header_length{};
+
+    /**
+     * @brief Load the unwinder before a stack trace handler is installed
+     * @details The first call to backtrace() may load libgcc, which allocates
+     *          and is not async-signal-safe; later calls are.
+     */
+    void prepare_stack_capture() noexcept {
+#if defined(_M_VCT_TEST_UNIT_BACKTRACE)
+        void* frame{};
+        ::backtrace(&frame, 1);
+#endif
+    }
+
+    /**
+     * @brief Symbolize the stack trace captured by capture_stack_handler()
+     * @return One frame per line, without the signal handler
+     */
+    std::string symbolize_captured_stack() {
+        std::string text;
+#if defined(_M_VCT_TEST_UNIT_BACKTRACE)
+        char** const symbols = ::backtrace_symbols(captured_frames.data(), captured_frame_count);
+        if (symbols == nullptr) return text;
+        for (int i = 1; i < captured_frame_count; ++i) {
+            text += std::format("{:>3}# {}\n", i - 1, symbols[i]);
+        }
+        std::free(symbols);
+#endif
+        return text;
+    }
+
+    /**
+     * @brief Signal handler storing the raw stack frames of the interrupted thread
+     * @details Async-signal-safe once prepare_stack_capture() has run; the
+     *          watchdog symbolizes the frames after captured_stack_ready is set.
+     */
+    void capture_stack_handler(int) {
+#if defined(_M_VCT_TEST_UNIT_BACKTRACE)
+        captured_frame_count = ::backtrace(captured_frames.data(), max_stack_frames);
+#endif
+        captured_stack_ready.store(true, std::memory_order_release);
+    }
+
+    /**
+     * @brief Signal handler writing the stack trace of the interrupted thread to stderr
+     * @details Async-signal-safe once prepare_stack_capture() has run and
+     *          stack_header is formatted: frames are written unbuffered by
+     *          backtrace_symbols_fd().
+     */
+    void print_stack_handler(int) {
+        write_all(STDERR_FILENO, stack_header.data(), stack_header_length);
+#if defined(_M_VCT_TEST_UNIT_BACKTRACE)
+        std::array<void*, max_stack_frames> frames;
+        const int count = ::backtrace(frames.data(), max_stack_frames);
+        if (count > 1) ::backtrace_symbols_fd(frames.data() + 1, count - 1, STDERR_FILENO);
+#else
+        constexpr std::string_view unavailable = "Stack traces are not available on this platform\n";
+        write_all(STDERR_FILENO, unavailable.data(), unavailable.size());
+#endif
+    }
+
+    /**
+     * @brief Install a signal handler
+     * @return The previously installed action
+     */
+    struct sigaction install_handler(const int sig, void (*handler)(int)) noexcept {
+        struct sigaction action{};
+        struct sigaction previous{};
+        action.sa_handler = handler;
+        ::sigemptyset(&action.sa_mask);
+        ::sigaction(sig, &action, &previous);
+        return previous;
+    }
+
+    /**
+     * @class ProcessPool
+     * @brief Pre-forked worker processes executing tests in isolation
+     * @details Each worker is forked once from the runner and then fed test
+     *          indices over a pipe; results come back over a second pipe. A
+     *          worker that dies (signal, abort, exit) is reported as a crash of
+     *          the test it was running and replaced by a freshly forked one, so
+     *          the cost of fork() is paid per crash instead of per test.
+     *          A worker whose test overruns its timeout is asked to print its
+     *          stack trace, then killed on a later round of the poll loop and
+     *          replaced the same way. Once the run deadline passes, no more
+     *          tests are dispatched and busy workers are timed out likewise.
+     *
+     *          A worker sets up a fixture suite for its first test of it and
+     *          tears it down when it receives a test of another suite or
+     *          exits, sending the outcome in a frame of its own. The result of
+     *          the last test of the suite is held back until every worker that
+     *          set the suite up has torn it down, and carries their failures.
+     *
+     *          With `tests_per_worker` > 0 (zygote mode), a worker exits after
+     *          that many tests and the next batch runs in a process freshly
+     *          forked from the runner. Tests then never see each other's
+     *          changes, and the suite hooks are left to the runner, whose
+     *          prepared state every worker inherits copy-on-write.
+     */
+    class ProcessPool {
+    public:
+        /**
+         * @brief Callback receiving results in completion order
+         * @details Invoked as on_result(index, results) once a test has finished,
+         *          with one result per instance of a parameterized test;
+         *          returning false stops the run.
+         */
+        using ResultHandler = std::function<bool(std::size_t, std::vector<TestResult>&&)>;
+
+        /**
+         * @param plan The flattened test plan, shared with the forked workers
+         * @param worker_count Number of worker processes (at least 1)
+         * @param default_timeout Timeout of tests without their own, 0 = none
+         * @param run_deadline End of the global timeout of the run, clock::time_point::max() = none
+         * @param tests_per_worker Tests run by a worker before it is replaced, 0 = unlimited
+         */
+        ProcessPool(
+            const std::span<const PlannedTest> plan, const std::size_t worker_count,
+            const std::chrono::milliseconds default_timeout, const clock::time_point run_deadline,
+            const std::size_t tests_per_worker = 0
+        ) : m_plan(plan), m_workers(std::max<std::size_t>(worker_count, 1)),
+            m_default_timeout(default_timeout), m_run_deadline(run_deadline), m_tests_per_worker(tests_per_worker),
+            m_suite_last(plan.size()) {
+            for (std::size_t i = plan.size(); i-- > 0;) {
+                m_suite_last[i] = i + 1 < plan.size() && plan[i + 1].suite == plan[i].suite ? m_suite_last[i + 1] : i;
+            }
+        }
+
+        ProcessPool(const ProcessPool&) = delete;
+        ProcessPool& operator=(const ProcessPool&) = delete;
+
+        ~ProcessPool() { shutdown(); }
+
+        /**
+         * @brief Run the tests with plan indices [first, last)
+         * @param first First plan index to run
+         * @param last One past the last plan index to run
+         * @param on_result Receives each result as soon as it is available
+         * @return false if on_result requested a stop or the run deadline passed before all tests ran
+         */
+        bool run(const std::size_t first, const std::size_t last, const ResultHandler& on_result) {
+            std::vector<std::size_t> tasks(last - first);
+            std::iota(tasks.begin(), tasks.end(), first);
+            return run(tasks, on_result);
+        }
+
+        /**
+         * @brief Run the tests with the given plan indices, dispatched in this order
+         * @param tasks Plan indices to run
+         * @param on_result Receives each result as soon as it is available
+         * @return false if on_result requested a stop or the run deadline passed before all tests ran
+         */
+        bool run(const std::span<const std::size_t> tasks, const ResultHandler& on_result) {
+            // A worker dying between two tasks must not kill the runner through SIGPIPE
+            const auto previous_sigpipe = ::signal(SIGPIPE, SIG_IGN);
+
+            std::size_t position = 0;
+            std::size_t outstanding = 0;
+            bool keep_going = true;
+
+            // Zygote workers leave the suite hooks to the runner
+            m_held.clear();
+            if (m_tests_per_worker == 0) {
+                for (const std::size_t index : tasks) {
+                    if (has_hooks(index)) ++m_held[m_suite_last[index]].remaining;
+                }
+            }
+
+            // Reports the held results of suites whose teardowns are all in, or of all suites at the end
+            const auto release = [&](const bool all) {
+                for (auto held = m_held.begin(); held != m_held.end();) {
+                    if (!all && (held->second.remaining > 0 || held->second.open > 0)) {
+                        ++held;
+                        continue;
+                    }
+                    const std::size_t index = held->first;
+                    auto suite = std::move(held->second);
+                    held = m_held.erase(held);
+                    if (!suite.last_results) continue;
+                    auto& results = *suite.last_results;
+                    // Like in-process runs, a parameterized test keeps its instances' outcomes
+                    if (suite.tear_down.outcome != TestResult::Outcome::Passed && (m_plan[index].params != nullptr || results.empty())) {
+                        TestResult result;
+                        result.begin = result.end = clock::now();
+                        results.push_back(std::move(result));
+                    }
+                    merge_suite_tear_down(results.back(), std::move(suite.tear_down), m_plan[index].suite);
+                    if (!on_result(index, std::move(results))) return false;
+                }
+                return true;
+            };
+
+            // Passes the results of a test on, holding back the last test of a suite with hooks
+            const auto finish = [&](const std::size_t index, std::vector<TestResult>&& results) {
+                const auto held = m_held.find(m_suite_last[index]);
+                if (held == m_held.end()) return on_result(index, std::move(results));
+                --held->second.remaining;
+                if (index == held->first) held->second.last_results = std::move(results);
+                else if (!on_result(index, std::move(results))) return false;
+                return release(false);
+            };
+
+            const auto dispatch = [&](Worker& worker) {
+                while (position < tasks.size() && keep_going && clock::now() < m_run_deadline) {
+                    const std::size_t next = tasks[position];
+                    // A worker that has run its batch exits on its own; replace it
+                    if (worker.pid >= 0 && m_tests_per_worker > 0 && worker.dispatched >= m_tests_per_worker) reap(worker);
+                    if (worker.pid < 0 && !spawn(worker)) {
+                        TestResult result;
+                        result.outcome = TestResult::Outcome::Crashed;
+                        result.begin = result.end = clock::now();
+                        result.failures.push_back({ std::format("could not start a worker process: {}", ::strerror(errno)) });
+                        std::vector<TestResult> results;
+                        results.push_back(std::move(result));
+                        ++position;
+                        keep_going = finish(next, std::move(results));
+                        continue;
+                    }
+                    const std::uint64_t index = next;
+                    if (write_all(worker.task_fd, &index, sizeof(index))) {
+                        const auto timeout = timeout_of(next);
+                        worker.current = next;
+                        ++position;
+                        ++worker.dispatched;
+                        worker.started = clock::now();
+                        worker.deadline = timeout > std::chrono::milliseconds::zero()
+                            ? worker.started + timeout
+                            : clock::time_point::max();
+                        worker.kill_at.reset();
+                        ++outstanding;
+                        // The worker sets the suite up, and reports its teardown when it moves on
+                        const auto held = m_held.find(m_suite_last[next]);
+                        if (held != m_held.end() && std::ranges::find(worker.open_suites, held->first) == worker.open_suites.end()) {
+                            worker.open_suites.push_back(held->first);
+                            ++held->second.open;
+                        }
+                        return;
+                    }
+                    // Worker vanished before receiving the task, retry with a fresh one
+                    reap(worker);
+                }
+            };
+
+            for (auto& worker : m_workers) dispatch(worker);
+
+            std::vector<pollfd> fds;
+            while (outstanding > 0 && keep_going) {
+                fds.clear();
+                auto next_deadline = clock::time_point::max();
+                for (const auto& worker : m_workers) {
+                    fds.push_back({ worker.current ? worker.result_fd : -1, POLLIN, 0 });
+                    if (worker.current) next_deadline = std::min(next_deadline, expiry(worker));
+                }
+                int wait_ms = -1;
+                if (next_deadline != clock::time_point::max()) {
+                    const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(next_deadline - clock::now());
+                    wait_ms = static_cast<int>(std::clamp<std::chrono::milliseconds::rep>(remaining.count(), 0, std::numeric_limits<int>::max()));
+                }
+                if (::poll(fds.data(), static_cast<nfds_t>(fds.size()), wait_ms) < 0) {
+                    if (errno == EINTR) continue;
+                    break;
+                }
+
+                // Workers whose test overran its timeout are asked for their
+                // stack, then killed once they had the time to print it
+                const auto now = clock::now();
+                for (std::size_t w = 0; w < m_workers.size() && keep_going; ++w) {
+                    auto& worker = m_workers[w];
+                    if (!worker.current || now < expiry(worker)) continue;
+                    if (!worker.kill_at) {
+                        ::kill(worker.pid, stack_trace_signal);
+                        worker.kill_at = now + stack_trace_grace;
+                        continue;
+                    }
+                    ::kill(worker.pid, SIGKILL);
+
+                    const auto index = *worker.current;
+                    TestResult result;
+                    result.outcome = TestResult::Outcome::Timeout;
+                    result.begin = worker.started;
+                    result.end = now;
+                    result.param_index = running_instance(worker);
+                    result.failures.push_back({ timeout_message(worker) });
+                    auto results = std::move(worker.results);
+                    results.push_back(std::move(result));
+                    reap(worker);
+                    fds[w].revents = 0;
+                    --outstanding;
+                    keep_going = finish(index, std::move(results));
+                    if (keep_going) dispatch(worker);
+                }
+
+                for (std::size_t w = 0; w < m_workers.size() && keep_going; ++w) {
+                    if (fds[w].revents == 0) continue;
+                    auto& worker = m_workers[w];
+
+                    char chunk[65536];
+                    const auto got = ::read(worker.result_fd, chunk, sizeof(chunk));
+                    if (got < 0 && errno == EINTR) continue;
+
+                    if (got > 0) {
+                        worker.buffer.append(chunk, static_cast<std::size_t>(got));
+                        while (auto frame = take_frame(worker)) {
+                            if (frame->first & suite_tear_down_flag) {
+                                close_suite(worker, frame->first & ~suite_tear_down_flag, std::move(*frame->second));
+                                keep_going = release(false);
+                                if (!keep_going) break;
+                                continue;
+                            }
+                            if (frame->second) {
+                                // Each instance of a parameterized test gets a full timeout of its own
+                                worker.results.push_back(std::move(*frame->second));
+                                worker.started = clock::now();
+                                const auto timeout = timeout_of(frame->first);
+                                if (timeout > std::chrono::milliseconds::zero()) worker.deadline = worker.started + timeout;
+                                worker.kill_at.reset();
+                                continue;
+                            }
+                            --outstanding;
+                            worker.current.reset();
+                            keep_going = finish(frame->first, std::exchange(worker.results, {}));
+                            if (!keep_going) break;
+                            dispatch(worker);
+                        }
+                        continue;
+                    }
+
+                    // End of file: the worker died, report the test it was running
+                    const auto crashed = worker.current;
+                    // Dying while printing its stack still counts as the timeout that was handled
+                    const bool timed_out = worker.kill_at.has_value();
+                    TestResult result;
+                    result.outcome = timed_out ? TestResult::Outcome::Timeout : TestResult::Outcome::Crashed;
+                    result.begin = worker.started;
+                    result.param_index = running_instance(worker);
+                    auto message = timed_out ? timeout_message(worker) : std::string{};
+                    auto results = std::move(worker.results);
+                    const int status = reap(worker);
+                    if (crashed) {
+                        --outstanding;
+                        result.end = clock::now();
+                        result.failures.push_back({ timed_out ? std::move(message) : describe_exit(status) });
+                        results.push_back(std::move(result));
+                        keep_going = finish(*crashed, std::move(results));
+                    }
+                    if (keep_going) dispatch(worker);
+                }
+            }
+
+            // Idle workers tear down the suites they still have set up once their task pipe is closed
+            if (keep_going && !m_held.empty()) {
+                for (auto& worker : m_workers) {
+                    if (worker.pid < 0) continue;
+                    ::close(worker.task_fd);
+                    worker.task_fd = -1;
+                    drain(worker);
+                    reap(worker);
+                }
+                keep_going = release(true);
+            }
+
+            if (!keep_going) shutdown();
+            ::signal(SIGPIPE, previous_sigpipe);
+            return keep_going && position == tasks.size();
+        }
+
+        /**
+         * @brief Stop all workers and wait for them to exit
+         */
+        void shutdown() noexcept {
+            for (auto& worker : m_workers) {
+                if (worker.pid < 0) continue;
+                // Busy workers are killed, idle ones exit on end of file
+                if (worker.current) ::kill(worker.pid, SIGKILL);
+                reap(worker);
+            }
+        }
+
+    private:
+        struct Worker {
+            ::pid_t pid{ -1 };
+            int task_fd{ -1 };                      ///< Write end of the task pipe
+            int result_fd{ -1 };                    ///< Read end of the result pipe
+            std::optional<std::size_t> current{};   ///< Plan index of the running test
+            clock::time_point started{};            ///< Dispatch time of the running test
+            clock::time_point deadline{};           ///< Time at which the running test times out
+            std::optional<clock::time_point> kill_at{};     ///< Set once the stack trace was requested
+            std::string buffer{};                   ///< Partially received result frames
+            std::vector<TestResult> results{};      ///< Results of the running test received so far
+            std::size_t dispatched{};               ///< Tests sent to this process
+            std::vector<std::size_t> open_suites{}; ///< Suites with hooks set up by this process, by their last plan index
+        };
+
+        /**
+         * @struct HeldSuite
+         * @brief Suite with hooks whose last result waits for the teardowns of its workers
+         */
+        struct HeldSuite {
+            std::size_t remaining{};                ///< Tests of the suite in this run without a result yet
+            std::size_t open{};                     ///< Live workers that have the suite set up
+            std::optional<std::vector<TestResult>> last_results{};  ///< Results of the last test of the suite
+            TestResult tear_down{};                 ///< Teardown failures received so far
+        };
+
+        /**
+         * @brief Fork a new worker process
+         * @return false if pipes or the process could not be created
+         */
+        bool spawn(Worker& worker) {
+            int task_pipe[2];
+            int result_pipe[2];
+            if (::pipe(task_pipe) != 0) return false;
+            if (::pipe(result_pipe) != 0) {
+                ::close(task_pipe[0]);
+                ::close(task_pipe[1]);
+                return false;
+            }
+
+            // Pending output would otherwise be flushed by both processes
+            std::fflush(nullptr);
+
+            const ::pid_t pid = ::fork();
+            if (pid < 0) {
+                for (const int fd : { task_pipe[0], task_pipe[1], result_pipe[0], result_pipe[1] }) ::close(fd);
+                return false;
+            }
+            if (pid == 0) {
+                // Drop the runner's ends of every other worker's pipes so that
+                // their end-of-file and crash detection keep working
+                for (const auto& other : m_workers) {
+                    if (other.task_fd >= 0) ::close(other.task_fd);
+                    if (other.result_fd >= 0) ::close(other.result_fd);
+                }
+                ::close(task_pipe[1]);
+                ::close(result_pipe[0]);
+                worker_main(task_pipe[0], result_pipe[1]);
+            }
+
+            ::close(task_pipe[0]);
+            ::close(result_pipe[1]);
+            worker.pid = pid;
+            worker.task_fd = task_pipe[1];
+            worker.result_fd = result_pipe[0];
+            worker.current.reset();
+            worker.buffer.clear();
+            worker.results.clear();
+            worker.dispatched = 0;
+            return true;
+        }
+
+        /**
+         * @brief Body of a worker process: run tasks until the task pipe is closed or the batch is done
+         */
+        [[noreturn]] void worker_main(const int task_fd, const int result_fd) {
+            const auto header = std::format_to_n(stack_header.data(), stack_header.size(),
+                "[ TIMEOUT  ] Stack trace of worker process {}:\n", static_cast<long>(::getpid()));
+            stack_header_length = static_cast<std::size_t>(header.out - stack_header.data());
+            prepare_stack_capture();
+            install_handler(stack_trace_signal, &print_stack_handler);
+            // Suites are set up once per worker process, and torn down when it moves on to another suite or exits.
+            // Zygote workers inherit suites already set up by the runner.
+            SuiteFixtures fixtures{ m_tests_per_worker > 0 ? std::span<const PlannedTest>{} : m_plan };
+            std::uint64_t index{};
+            std::size_t done = 0;
+            bool connected = true;
+            // A test of the suite with hooks this process is in, whose teardown the runner waits for
+            std::optional<std::size_t> entered;
+            const auto leave_suite = [&] {
+                if (!entered) return;
+                const auto tear_down = fixtures.tear_down_suite(*entered);
+                std::fflush(nullptr);
+                const auto frame = encode_result(suite_tear_down_flag | *entered, tear_down);
+                connected = connected && write_all(result_fd, frame.data(), frame.size());
+                entered.reset();
+            };
+            // Results are sent as they come, so a crash keeps the instances finished before it
+            const ResultSink sink{ {}, [&](TestResult&& result) {
+                std::fflush(nullptr);
+                const auto frame = encode_result(index, result);
+                connected = write_all(result_fd, frame.data(), frame.size());
+                return connected && result.outcome != TestResult::Outcome::Assert;
+            } };
+            while (read_all(task_fd, &index, sizeof(index))) {
+                if (index < m_plan.size()) {
+                    if (m_tests_per_worker > 0) {
+                        run_test(m_plan[index], sink);
+                    } else {
+                        if (entered && m_plan[*entered].suite != m_plan[index].suite) leave_suite();
+                        if (has_hooks(index)) entered = index;
+                        fixtures.run(index, sink);
+                    }
+                }
+                std::fflush(nullptr);
+                const auto frame = encode_done(index);
+                if (!connected || !write_all(result_fd, frame.data(), frame.size())) break;
+                if (m_tests_per_worker > 0 && ++done == m_tests_per_worker) break;
+            }
+            if (connected) leave_suite();
+            fixtures.tear_down_remaining();
+            std::fflush(nullptr);
+            ::_exit(0);
+        }
+
+        /// Whether the suite of plan[index] has SetUpTestSuite() or TearDownTestSuite() hooks
+        bool has_hooks(const std::size_t index) const noexcept {
+            return m_plan[index].hooks.set_up != nullptr || m_plan[index].hooks.tear_down != nullptr;
+        }
+
+        /**
+         * @brief Record the teardown of a suite received from a worker
+         * @param index Plan index of a test of the suite
+         * @param tear_down Outcome of its TearDownTestSuite()
+         */
+        void close_suite(Worker& worker, const std::size_t index, TestResult&& tear_down) {
+            const auto key = m_suite_last[index];
+            const auto open = std::ranges::find(worker.open_suites, key);
+            if (open == worker.open_suites.end()) return;
+            worker.open_suites.erase(open);
+            const auto held = m_held.find(key);
+            if (held == m_held.end()) return;
+            --held->second.open;
+            auto& merged = held->second.tear_down;
+            if (tear_down.outcome == TestResult::Outcome::Passed) return;
+            if (merged.outcome == TestResult::Outcome::Passed) merged.outcome = tear_down.outcome;
+            std::ranges::move(tear_down.failures, std::back_inserter(merged.failures));
+        }
+
+        /**
+         * @brief Read the remaining frames of a worker whose task pipe is closed, until it exits
+         * @details Only suite teardown frames are expected. A worker still
+         *          running when the run deadline passes is killed.
+         */
+        void drain(Worker& worker) {
+            while (true) {
+                pollfd fd{ worker.result_fd, POLLIN, 0 };
+                int wait_ms = -1;
+                if (m_run_deadline != clock::time_point::max()) {
+                    const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(m_run_deadline - clock::now());
+                    wait_ms = static_cast<int>(std::clamp<std::chrono::milliseconds::rep>(remaining.count(), 0, std::numeric_limits<int>::max()));
+                }
+                const int ready = ::poll(&fd, 1, wait_ms);
+                if (ready < 0 && errno == EINTR) continue;
+                if (ready <= 0) {
+                    ::kill(worker.pid, SIGKILL);
+                    return;
+                }
+
+                char chunk[4096];
+                const auto got = ::read(worker.result_fd, chunk, sizeof(chunk));
+                if (got < 0 && errno == EINTR) continue;
+                if (got <= 0) return;
+                worker.buffer.append(chunk, static_cast<std::size_t>(got));
+                while (auto frame = take_frame(worker)) {
+                    if ((frame->first & suite_tear_down_flag) && frame->second) {
+                        close_suite(worker, frame->first & ~suite_tear_down_flag, std::move(*frame->second));
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Close a worker's pipes and wait for its process
+         * @return The waitpid() status of the worker
+         * @details Suites the worker had set up are no longer waited for.
+         */
+        int reap(Worker& worker) noexcept {
+            for (const auto key : worker.open_suites) {
+                if (const auto held = m_held.find(key); held != m_held.end()) --held->second.open;
+            }
+            worker.open_suites.clear();
+            if (worker.task_fd >= 0) ::close(worker.task_fd);
+            if (worker.result_fd >= 0) ::close(worker.result_fd);
+            int status = 0;
+            if (worker.pid >= 0) {
+                while (::waitpid(worker.pid, &status, 0) < 0 && errno == EINTR) {}
+            }
+            worker.pid = -1;
+            worker.task_fd = -1;
+            worker.result_fd = -1;
+            worker.current.reset();
+            worker.buffer.clear();
+            worker.results.clear();
+            return status;
+        }
+
+        /// Parameter instance a worker was running when it died, if its test is parameterized
+        std::optional<std::size_t> running_instance(const Worker& worker) const {
+            if (!worker.current || m_plan[*worker.current].params == nullptr) return std::nullopt;
+            const auto& results = worker.results;
+            return results.empty() || !results.back().param_index ? 0 : *results.back().param_index + 1;
+        }
+
+        /**
+         * @brief Extract one complete frame from a worker's receive buffer
+         * @return Plan index and result, or plan index and std::nullopt for the end of a test
+         */
+        static std::optional<std::pair<std::size_t, std::optional<TestResult>>> take_frame(Worker& worker) {
+            constexpr std::size_t header = 2 * sizeof(std::uint64_t);
+            if (worker.buffer.size() < header) return std::nullopt;
+
+            std::uint64_t index{}, size{};
+            std::memcpy(&index, worker.buffer.data(), sizeof(index));
+            std::memcpy(&size, worker.buffer.data() + sizeof(index), sizeof(size));
+            if (worker.buffer.size() < header + size) return std::nullopt;
+            if (size == 0) {
+                worker.buffer.erase(0, header);
+                return std::pair{ static_cast<std::size_t>(index), std::optional<TestResult>{} };
+            }
+
+            auto result = decode_result(std::string_view{ worker.buffer }.substr(header, size));
+            worker.buffer.erase(0, header + size);
+            if (!result) {
+                TestResult broken;
+                broken.outcome = TestResult::Outcome::Crashed;
+                broken.failures.push_back({ "malformed result received from worker process" });
+                result = std::move(broken);
+            }
+            return std::pair{ static_cast<std::size_t>(index), std::move(result) };
+        }
+
+        /// Effective timeout of a test, 0 = none
+        std::chrono::milliseconds timeout_of(const std::size_t index) const noexcept {
+            const auto own = m_plan[index].options.timeout;
+            return own > std::chrono::milliseconds::zero() ? own : m_default_timeout;
+        }
+
+        /// Next time at which the poll loop must act on a busy worker
+        clock::time_point expiry(const Worker& worker) const noexcept {
+            return worker.kill_at ? *worker.kill_at : std::min(worker.deadline, m_run_deadline);
+        }
+
+        /// Failure of a test whose worker is killed by the timeout handling
+        std::string timeout_message(const Worker& worker) const {
+            if (worker.deadline > m_run_deadline) return "still running when the global timeout expired, worker process killed";
+            return std::format("exceeded the timeout of {} ms, worker process killed", timeout_of(*worker.current).count());
+        }
+
+        std::span<const PlannedTest> m_plan;
+        std::vector<Worker> m_workers;
+        std::chrono::milliseconds m_default_timeout{};
+        clock::time_point m_run_deadline{};
+        std::size_t m_tests_per_worker{};
+        std::vector<std::size_t> m_suite_last;      ///< Plan index of the last test of each test's suite
+        std::map<std::size_t, HeldSuite> m_held;    ///< Suites with hooks of the current run, by the plan index of their last test
+    };
+
+#endif // _M_VCT_TEST_UNIT_POSIX
+
+    /// Whether `--isolate` runs tests in worker processes on this platform
+#if defined(_M_VCT_TEST_UNIT_POSIX)
+    constexpr bool process_isolation_supported = true;
+#else
+    constexpr bool process_isolation_supported = false;
+#endif
+
+    /**
+     * @class Watchdog
+     * @brief Background thread aborting the run when an in-process test overruns its timeout
+     * @details Threads running a test arm a deadline with watch() for the
+     *          duration of the test. When a deadline passes, the watchdog
+     *          prints the hung test, asks its thread for a stack trace (POSIX,
+     *          through stack_trace_signal) and terminates the process, since a
+     *          hung thread cannot be cancelled safely. A run deadline set with
+     *          limit_run() ends the process the same way. The thread is only
+     *          started once a test with a timeout is watched or a run deadline
+     *          is set.
+     */
+    class Watchdog {
+    public:
+        /**
+         * @class Guard
+         * @brief Disarms a watched deadline when the test finishes
+         */
+        class Guard {
+        public:
+            Guard() noexcept = default;
+            Guard(Watchdog* owner, const std::size_t id) noexcept : m_owner(owner), m_id(id) {}
+            Guard(Guard&& other) noexcept : m_owner(std::exchange(other.m_owner, nullptr)), m_id(other.m_id) {}
+            Guard& operator=(Guard&&) = delete;
+            ~Guard() { if (m_owner != nullptr) m_owner->disarm(m_id); }
+
+            /**
+             * @brief Give the next instance of a parameterized test a full timeout of its own
+             * @param param_index The instance about to run
+             */
+            void restart(const std::size_t param_index) {
+                if (m_owner != nullptr) m_owner->rearm(m_id, param_index);
+            }
+
+        private:
+            Watchdog* m_owner{};
+            std::size_t m_id{};
+        };
+
+        /**
+         * @param before_expire Called on the watchdog thread before a hung test is printed
+         */
+        explicit Watchdog(std::function<void()> before_expire = {}) : m_before_expire(std::move(before_expire)) {}
+        Watchdog(const Watchdog&) = delete;
+        Watchdog& operator=(const Watchdog&) = delete;
+
+        ~Watchdog() {
+            {
+                std::lock_guard lock{ m_mutex };
+                m_stop = true;
+            }
+            m_wakeup.notify_all();
+            if (m_thread.joinable()) m_thread.join();
+#if defined(_M_VCT_TEST_UNIT_POSIX)
+            if (m_handler_installed) ::sigaction(stack_trace_signal, &m_previous_handler, nullptr);
+#endif
+        }
+
+        /**
+         * @brief Watch the test about to run on the calling thread
+         * @param test The test
+         * @param timeout Its effective timeout, 0 = not watched
+         * @return Guard that disarms the deadline when destroyed
+         */
+        [[nodiscard]] Guard watch(const PlannedTest& test, const std::chrono::milliseconds timeout) {
+            if (timeout <= std::chrono::milliseconds::zero()) return {};
+
+            std::size_t id{};
+            {
+                std::lock_guard lock{ m_mutex };
+                start_thread();
+                id = ++m_next_id;
+                Slot slot{ test.suite, test.name, std::nullopt, timeout, clock::now() + timeout };
+#if defined(_M_VCT_TEST_UNIT_POSIX)
+                slot.thread = ::pthread_self();
+#endif
+                m_slots.emplace(id, slot);
+            }
+            m_wakeup.notify_all();
+            return { this, id };
+        }
+
+        /**
+         * @brief Abort the run when the global timeout expires
+         * @param begin Start of the run
+         * @param timeout Wall-clock limit of the whole run, 0 = none
+         */
+        void limit_run(const clock::time_point begin, const std::chrono::milliseconds timeout) {
+            if (timeout <= std::chrono::milliseconds::zero()) return;
+            {
+                std::lock_guard lock{ m_mutex };
+                start_thread();
+                m_run_timeout = timeout;
+                m_run_deadline = begin + timeout;
+            }
+            m_wakeup.notify_all();
+        }
+
+    private:
+        struct Slot {
+            std::string_view suite{};
+            std::string_view name{};
+            std::optional<std::size_t> param_index{};
+            std::chrono::milliseconds timeout{};
+            clock::time_point deadline{};
+#if defined(_M_VCT_TEST_UNIT_POSIX)
+            ::pthread_t thread{};
+#endif
+        };
+
+        /// Start the watchdog thread if not running yet, with m_mutex held
+        void start_thread() {
+            if (m_thread.joinable()) return;
+#if defined(_M_VCT_TEST_UNIT_POSIX)
+            prepare_stack_capture();
+            m_previous_handler = install_handler(stack_trace_signal, &capture_stack_handler);
+            m_handler_installed = true;
+#endif
+            m_thread = std::thread{ [this] { loop(); } };
+        }
+
+        void disarm(const std::size_t id) {
+            std::lock_guard lock{ m_mutex };
+            m_slots.erase(id);
+        }
+
+        void rearm(const std::size_t id, const std::size_t param_index) {
+            {
+                std::lock_guard lock{ m_mutex };
+                const auto slot = m_slots.find(id);
+                if (slot == m_slots.end()) return;
+                slot->second.param_index = param_index;
+                slot->second.deadline = clock::now() + slot->second.timeout;
+            }
+            m_wakeup.notify_all();
+        }
+
+        void loop() {
+            std::unique_lock lock{ m_mutex };
+            while (!m_stop) {
+                const auto earliest = std::ranges::min_element(m_slots, {}, [](const auto& entry) { return entry.second.deadline; });
+                const auto deadline = earliest == m_slots.end() ? m_run_deadline : std::min(earliest->second.deadline, m_run_deadline);
+                if (deadline == clock::time_point::max()) {
+                    m_wakeup.wait(lock);
+                } else if (clock::now() < deadline) {
+                    m_wakeup.wait_until(lock, deadline);
+                } else if (deadline == m_run_deadline) {
+                    // Flushing the events may wait for threads that take m_mutex to disarm their test
+                    const auto running = m_slots;
+                    lock.unlock();
+                    expire_run(running);
+                } else {
+                    const auto slot = earliest->second;
+                    lock.unlock();
+                    expire(slot);
+                }
+            }
+        }
+
+        /// Called without m_mutex held, with the tests running when the run deadline passed
+        [[noreturn]] void expire_run(const std::map<std::size_t, Slot>& running) {
+            if (m_before_expire) m_before_expire();
+            std::println("[ TIMEOUT  ] Global timeout of {} ms expired, aborting the run", m_run_timeout.count());
+            for (const auto& [id, slot] : running) {
+                std::println("[ TIMEOUT  ] {}.{} was still running", slot.suite, instance_name(slot.name, slot.param_index));
+            }
+            std::fflush(nullptr);
+            std::_Exit(1);
+        }
+
+        /// Called without m_mutex held, with a copy of the slot of the hung test
+        [[noreturn]] void expire(const Slot& slot) {
+            if (m_before_expire) m_before_expire();
+            const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(clock::now() - (slot.deadline - slot.timeout));
+            std::println("[ TIMEOUT  ] {}.{}  ({} ms)", slot.suite, instance_name(slot.name, slot.param_index), elapsed.count());
+            std::println("[  FAILED  ] exceeded the timeout of {} ms, aborting the run", slot.timeout.count());
+#if defined(_M_VCT_TEST_UNIT_POSIX)
+            captured_stack_ready.store(false);
+            if (::pthread_kill(slot.thread, stack_trace_signal) == 0) {
+                for (int i = 0; i < 100 && !captured_stack_ready.load(std::memory_order_acquire); ++i) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds{ 10 });
+                }
+            }
+            const auto stack = captured_stack_ready.load(std::memory_order_acquire) ? symbolize_captured_stack() : std::string{};
+            if (!stack.empty()) {
+                std::println("[ TIMEOUT  ] Stack trace of the hung test:\n{}", stack);
+            } else {
+                std::println("[ TIMEOUT  ] Stack trace of the hung test is not available");
+            }
+#else
+            std::println("[ TIMEOUT  ] Stack traces of other threads are not available on this platform");
+#endif
+            std::fflush(nullptr);
+            std::_Exit(1);
+        }
+
+        std::function<void()> m_before_expire;
+        std::mutex m_mutex;
+        std::condition_variable m_wakeup;
+        std::map<std::size_t, Slot> m_slots;
+        std::size_t m_next_id{};
+        std::chrono::milliseconds m_run_timeout{};
+        clock::time_point m_run_deadline{ clock::time_point::max() };
+        bool m_stop{ false };
+        std::thread m_thread;
+#if defined(_M_VCT_TEST_UNIT_POSIX)
+        struct sigaction m_previous_handler{};
+        bool m_handler_installed{ false };
+#endif
+    };
+
+    /**
+     * @struct SampleStats
+     * @brief Summary statistics of a set of measurements
+     */
+    struct SampleStats {
+        double mean{};
+        double median{};
+        double stddev{};                ///< Sample standard deviation
+        double min{};
+        double max{};
+    };
+
+    /**
+     * @brief Compute summary statistics of a set of measurements
+     * @param samples The measurements, reordered in place
+     * @return The statistics, all zero for an empty set
+     */
+    SampleStats summarize(std::span<double> samples) {
+        SampleStats stats;
+        if (samples.empty()) return stats;
+
+        std::ranges::sort(samples);
+        const std::size_t n = samples.size();
+        stats.min = samples.front();
+        stats.max = samples.back();
+        stats.median = n % 2 == 1 ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+        stats.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(n);
+        if (n > 1) {
+            double sum_sq = 0;
+            for (const double x : samples) sum_sq += (x - stats.mean) * (x - stats.mean);
+            stats.stddev = std::sqrt(sum_sq / static_cast<double>(n - 1));
+        }
+        return stats;
+    }
+
+    /**
+     * @struct BenchmarkResult
+     * @brief Outcome and measurements of a single benchmark
+     */
+    struct BenchmarkResult {
+        TestResult result{};            ///< Failures recorded or thrown by the benchmark body
+        std::size_t iterations{};       ///< Calibrated iterations per sample
+        std::vector<double> samples{};  ///< Metric per iteration (nanoseconds for the time), one entry per sample
+        SampleStats stats{};            ///< Statistics over `samples`
+        std::vector<CounterValue> counters{};   ///< Performance counters over all samples, with `--perf-counters`
+        LatencyHistogram latencies{};   ///< Latencies recorded during the samples
+    };
+
+    /**
+     * @struct BenchmarkMeter
+     * @brief Event counter of a benchmark metric other than the time
+     */
+    struct BenchmarkMeter {
+        BenchmarkState::Meter read{};   ///< Empty for the time metric
+        std::optional<PerfCounter> counter{};   ///< Counter behind `read`, opened again by each benchmark thread
+        double overhead{};              ///< Count of an empty benchmark loop, removed from each sample
+    };
+
+    /**
+     * @brief Measure the meter count of an empty benchmark loop
+     * @details The least of many runs; for instructions it is the same in every run.
+     */
+    double measure_meter_overhead(const BenchmarkState::Meter& meter) {
+        std::uint64_t least = std::numeric_limits<std::uint64_t>::max();
+        for (int i = 0; i < 101; ++i) {
+            BenchmarkState state{ 0, { .meter = &meter } };
+            for (auto _ : state) {}
+            least = std::min(least, state.metered());
+        }
+        return static_cast<double>(least);
+    }
+
+    /**
+     * @brief Get the thread counts a benchmark runs with
+     * @return min_threads, then doubled up to max_threads, which is always included
+     */
+    std::vector<std::size_t> benchmark_thread_counts(const BenchmarkOptions& options) {
+        const std::size_t max_threads = options.max_threads != 0
+            ? options.max_threads : std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+        const std::size_t min_threads = std::clamp<std::size_t>(options.min_threads, 1, max_threads);
+        std::vector<std::size_t> counts;
+        for (std::size_t threads = min_threads; threads < max_threads; threads *= 2) counts.push_back(threads);
+        counts.push_back(max_threads);
+        return counts;
+    }
+
+    /**
+     * @brief Pin the calling thread to the index-th CPU it is allowed to run on
+     * @details Wraps around if there are fewer CPUs than threads. Does
+     *          nothing on platforms other than Linux.
+     */
+    void pin_thread([[maybe_unused]] const std::size_t index) noexcept {
+#if defined(__linux__)
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        if (::sched_getaffinity(0, sizeof(allowed), &allowed) != 0) return;
+        const auto count = static_cast<std::size_t>(CPU_COUNT(&allowed));
+        if (count == 0) return;
+        std::size_t skip = index % count;
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (!CPU_ISSET(cpu, &allowed) || skip-- != 0) continue;
+            cpu_set_t only;
+            CPU_ZERO(&only);
+            CPU_SET(cpu, &only);
+            ::pthread_setaffinity_np(::pthread_self(), sizeof(only), &only);
+            return;
+        }
+#endif
+    }
+
+    /**
+     * @struct BenchmarkSetup
+     * @brief How to run the benchmark body for one measurement
+     */
+    struct BenchmarkSetup {
+        std::size_t threads{ 1 };
+        bool pin_threads{ false };
+        const BenchmarkMeter* meter{};      ///< Counter of the metric, if it is not the time
+        LatencyHistogram* latencies{};      ///< Receives the recorded latencies, or nullptr
+        bool time_iterations{ false };      ///< Record the time of every iteration into `latencies`
+
+        /// Whether the body runs on dedicated threads instead of the calling one
+        bool dedicated() const noexcept { return threads > 1 || pin_threads; }
+    };
+
+    /**
+     * @struct BenchmarkRun
+     * @brief Measurements of one run of the benchmark body, on one or more threads
+     */
+    struct BenchmarkRun {
+        clock::duration elapsed{};      ///< Longest loop time of all threads
+        std::uint64_t metered{};        ///< Meter count summed over all threads
+        std::vector<CounterValue> counters{};   ///< Performance counters summed over dedicated threads
+    };
+
+    /**
+     * @brief Run the benchmark body once with a fixed number of iterations
+     * @param bench The benchmark to run
+     * @param iterations Loop iterations of each thread
+     * @param setup Threads, meter and latency recording of the run
+     * @return The time and meter count of the run
+     * @throws std::logic_error if the body never iterated over its state
+     * @throws AssertException if the body failed on one of several threads;
+     *         the failures of all threads are recorded for the running benchmark
+     * @details With several threads, each runs the body with its own state;
+     *          their loops start together behind a barrier. Each thread
+     *          opens its own meter counter and records into its own latency
+     *          histogram, merged afterwards.
+     */
+    BenchmarkRun run_benchmark_once(const BenchmarkCase& bench, const std::size_t iterations, const BenchmarkSetup& setup = {}) {
+        const BenchmarkState::Meter* meter = setup.meter != nullptr && setup.meter->read ? &setup.meter->read : nullptr;
+        if (!setup.dedicated()) {
+            BenchmarkState state{ iterations, { meter, setup.latencies, setup.time_iterations } };
+            bench.func(state);
+            if (!state.finished()) throw std::logic_error("benchmark body did not iterate over the state");
+            return { state.elapsed(), state.metered() };
+        }
+
+        const std::size_t threads = setup.threads;
+        std::barrier<> start{ static_cast<std::ptrdiff_t>(threads) };
+        std::vector<LatencyHistogram> latencies(setup.latencies != nullptr ? threads : 0);
+        std::vector<TestResult> results(threads);
+        std::vector<BenchmarkRun> runs(threads);
+        std::vector<char> finished(threads, false);
+        {
+            std::vector<std::jthread> workers;
+            workers.reserve(threads);
+            for (std::size_t i = 0; i < threads; ++i) {
+                workers.emplace_back([&, i] {
+                    if (setup.pin_threads) pin_thread(i);
+                    std::optional<PerfCounters> counters;
+                    BenchmarkState::Meter read;
+                    if (meter != nullptr && setup.meter->counter) {
+                        counters.emplace(std::initializer_list<PerfCounter>{ *setup.meter->counter });
+                        read = [&counters] { return counters->read().values[0]; };
+                    }
+                    BenchmarkState state{ iterations, {
+                        read ? &read : nullptr, latencies.empty() ? nullptr : &latencies[i],
+                        setup.time_iterations, i, threads, &start
+                    } };
+                    results[i] = run_guarded([&] { bench.func(state); });
+                    // Do not keep the other threads waiting for a body that never reached its loop
+                    if (!state.started()) start.arrive_and_drop();
+                    finished[i] = state.finished();
+                    runs[i] = { state.elapsed(), state.metered() };
+                });
+            }
+        }
+
+        BenchmarkRun run;
+        std::size_t failed = 0;
+        for (std::size_t i = 0; i < threads; ++i) {
+            run.elapsed = std::max(run.elapsed, runs[i].elapsed);
+            run.metered += runs[i].metered;
+            for (const auto& value : results[i].counters) {
+                const auto counter = std::ranges::find(run.counters, value.counter, &CounterValue::counter);
+                if (counter == run.counters.end()) run.counters.push_back(value);
+                else counter->value += value.value;
+            }
+            if (setup.latencies != nullptr) setup.latencies->merge(latencies[i]);
+            if (results[i].outcome == TestResult::Outcome::Passed) continue;
+            ++failed;
+            for (auto& failure : results[i].failures) {
+                failure.message = std::format("thread {}: {}", i, failure.message);
+                if (current_result != nullptr) current_result->failures.push_back(std::move(failure));
+            }
+        }
+        if (failed > 0) throw AssertException(std::format("{} of {} benchmark threads failed", failed, threads));
+        if (std::ranges::count(finished, false) > 0) throw std::logic_error("benchmark body did not iterate over the state");
+        return run;
+    }
+
+    /**
+     * @brief Find the number of iterations whose run lasts at least `target`
+     * @param probe Receives the latencies the body records itself, or nullptr
+     * @details Starts with a single iteration and grows the count by the
+     *          measured shortfall (between x2 and x10 per step).
+     */
+    std::size_t calibrate_iterations(
+        const BenchmarkCase& bench, const BenchmarkState::clock::duration target,
+        const std::size_t threads = 1, LatencyHistogram* probe = nullptr
+    ) {
+        constexpr std::size_t max_iterations = 1'000'000'000;
+        std::size_t iterations = 1;
+        while (true) {
+            const auto elapsed = run_benchmark_once(bench, iterations, {
+                .threads = threads, .pin_threads = bench.options.pin_threads, .latencies = probe
+            }).elapsed;
+            if (elapsed >= target || iterations >= max_iterations) return iterations;
+            const double ratio = elapsed.count() > 0
+                ? static_cast<double>(target.count()) / static_cast<double>(elapsed.count())
+                : 10.0;
+            const double growth = std::clamp(ratio * 1.2, 2.0, 10.0);
+            iterations = std::min(static_cast<std::size_t>(static_cast<double>(iterations) * growth), max_iterations);
+        }
+    }
+
+    /**
+     * @brief Calibrate, warm up and sample a single benchmark
+     * @param bench The benchmark to run
+     * @param threads Number of threads running the body concurrently
+     * @param options Warmup time, sample time and sample count
+     * @param format Provides the timer overhead removed from each sample
+     * @param meter Counter of the measured metric, if it is not the time
+     * @details A sample is the metric per iteration of one thread: the
+     *          longest loop time of all threads divided by the iterations, or
+     *          the meter count of all threads divided by all their iterations.
+     */
+    BenchmarkResult run_benchmark(
+        const BenchmarkCase& bench, const std::size_t threads, const RunOptions& options,
+        const TimeFormat& format, const BenchmarkMeter& meter
+    ) {
+        BenchmarkResult out;
+        out.result = run_guarded([&] {
+            // Bodies recording their own latencies are not timed per iteration
+            LatencyHistogram probe;
+            out.iterations = calibrate_iterations(bench, options.benchmark_min_time, threads, &probe);
+            const BenchmarkSetup setup{
+                threads, bench.options.pin_threads, &meter, &out.latencies,
+                options.benchmark_histogram && probe.count() == 0
+            };
+
+            const auto warmup_end = clock::now() + options.benchmark_warmup;
+            while (clock::now() < warmup_end) {
+                run_benchmark_once(bench, out.iterations, { .threads = threads, .pin_threads = setup.pin_threads });
+            }
+
+            out.samples.reserve(options.benchmark_repetitions);
+            // Counters of dedicated threads come with each run, those of this thread from a snapshot
+            const bool counting = perf_counters_enabled.load(std::memory_order_relaxed);
+            const auto counters_begin = counting && !setup.dedicated() ? PerfCounters::local().read() : PerfCounters::Snapshot{};
+            for (std::size_t i = 0; i < options.benchmark_repetitions; ++i) {
+                auto run = run_benchmark_once(bench, out.iterations, setup);
+                for (const auto& value : run.counters) {
+                    const auto counter = std::ranges::find(out.counters, value.counter, &CounterValue::counter);
+                    if (counter == out.counters.end()) out.counters.push_back(value);
+                    else counter->value += value.value;
+                }
+                if (meter.read) {
+                    const double count = static_cast<double>(run.metered) - meter.overhead * static_cast<double>(threads);
+                    out.samples.push_back(std::max(count, 0.0) / static_cast<double>(out.iterations * threads));
+                    continue;
+                }
+                const auto elapsed = std::chrono::duration<double, std::nano>(format.net(run.elapsed));
+                out.samples.push_back(elapsed.count() / static_cast<double>(out.iterations));
+            }
+            if (counting && !setup.dedicated()) out.counters = PerfCounters::local().since(counters_begin);
+        });
+        std::vector<double> sorted = out.samples;
+        out.stats = summarize(sorted);
+        return out;
+    }
+
+    /**
+     * @struct BaselineEntry
+     * @brief Results of one benchmark in an earlier run
+     */
+    struct BaselineEntry {
+        double median{};
+        std::vector<double> samples{};  ///< Metric per iteration, one entry per sample
+    };
+
+    /// Results of an earlier benchmark run, keyed by "Suite.Name"
+    using BenchmarkBaseline = std::map<std::string, BaselineEntry, std::less<>>;
+
+    /**
+     * @brief Load a benchmark baseline
+     * @param path File with one "Suite.Name metric median samples..." entry per line
+     * @param metric Only entries of this metric are loaded
+     * @return The entries, or std::nullopt if the file cannot be read
+     * @details Like load_durations(), fields are taken from the right: the
+     *          numbers, then the metric word, and the rest of the line is the
+     *          name, which may contain spaces for typed benchmarks.
+     */
+    std::optional<BenchmarkBaseline> load_benchmark_baseline(const std::string& path, const BenchmarkMetric metric) {
+        std::ifstream file{ path };
+        if (!file) return std::nullopt;
+        BenchmarkBaseline baseline;
+        std::string line;
+        while (std::getline(file, line)) {
+            std::string_view rest{ line };
+            std::string_view field;
+            std::vector<double> values;     // Right to left
+            // Pop the last field of `rest`, false if there is none
+            const auto pop = [&] {
+                const auto end = rest.find_last_not_of(" \t");
+                if (end == std::string_view::npos) return false;
+                const auto split = rest.find_last_of(" \t", end);
+                const auto begin = split == std::string_view::npos ? 0 : split + 1;
+                field = rest.substr(begin, end + 1 - begin);
+                rest = rest.substr(0, begin);
+                return true;
+            };
+            while (pop()) {
+                double value{};
+                const auto [ptr, ec] = std::from_chars(field.data(), field.data() + field.size(), value);
+                if (ec != std::errc{} || ptr != field.data() + field.size()) break;
+                values.push_back(value);
+            }
+            const auto end = rest.find_last_not_of(" \t");
+            const std::string_view name = rest.substr(0, end == std::string_view::npos ? 0 : end + 1);
+            if (values.empty() || name.empty() || field != metric_name(metric)) continue;
+
+            BaselineEntry entry{ .median = values.back() };
+            entry.samples.assign(values.rbegin() + 1, values.rend());
+            baseline.insert_or_assign(std::string{ name }, std::move(entry));
+        }
+        return baseline;
+    }
+
+    /// Significance level below which a change against the baseline is reported
+    constexpr double baseline_significance = 0.01;
+
+    /**
+     * @brief Two-sided p-value of the Mann-Whitney U test
+     * @param first Samples of one run
+     * @param second Samples of the other run
+     * @return Probability of a rank difference at least as large if both
+     *         runs measured the same distribution, 1 without samples
+     * @details Uses the normal approximation with tie and continuity
+     *          correction, accurate from about 8 samples per run on. The
+     *          test makes no assumption about the shape of the distributions,
+     *          which for timings are skewed by outliers.
+     */
+    double mann_whitney_p(std::span<const double> first, std::span<const double> second) {
+        const std::size_t n1 = first.size(), n2 = second.size(), n = n1 + n2;
+        if (n1 == 0 || n2 == 0) return 1.0;
+
+        std::vector<std::pair<double, bool>> values;   // value, belongs to `first`
+        values.reserve(n);
+        for (const double x : first) values.emplace_back(x, true);
+        for (const double x : second) values.emplace_back(x, false);
+        std::ranges::sort(values);
+
+        // Average ranks within runs of equal values
+        double first_rank_sum = 0, tie_sum = 0;
+        for (std::size_t i = 0; i < n;) {
+            std::size_t j = i;
+            while (j < n && values[j].first == values[i].first) ++j;
+            const double ties = static_cast<double>(j - i);
+            const double rank = static_cast<double>(i + j + 1) / 2;
+            for (std::size_t k = i; k < j; ++k) if (values[k].second) first_rank_sum += rank;
+            tie_sum += ties * ties * ties - ties;
+            i = j;
+        }
+
+        const double a = static_cast<double>(n1), b = static_cast<double>(n2), total = static_cast<double>(n);
+        const double u = first_rank_sum - a * (a + 1) / 2;
+        const double variance = a * b / 12 * ((total + 1) - tie_sum / (total * (total - 1)));
+        if (variance <= 0) return 1.0;
+        const double z = std::max(std::abs(u - a * b / 2) - 0.5, 0.0) / std::sqrt(variance);
+        return std::erfc(z / std::numbers::sqrt2);
+    }
+
+    /**
+     * @brief Describe the throughput of a multi-threaded benchmark per thread count
+     * @param name "Suite.Name" of the benchmark
+     * @param scaling Thread count and median time per iteration of each passed run
+     * @return The lines of the table, empty with fewer than two passed runs
+     * @details Speedup and efficiency are relative to the smallest thread
+     *          count; an efficiency of 100% means perfectly linear scaling.
+     */
+    std::vector<std::string> scaling_table(const std::string_view name, const std::span<const std::pair<std::size_t, double>> scaling) {
+        std::vector<std::string> lines;
+        if (scaling.size() < 2 || scaling.front().second <= 0) return lines;
+        const auto throughput = [](const std::pair<std::size_t, double>& run) {
+            return run.second > 0 ? static_cast<double>(run.first) * 1e9 / run.second : 0.0;
+        };
+        const double base = throughput(scaling.front());
+        lines.push_back(std::format("[ SCALING  ] {}", name));
+        lines.push_back(std::format("[ SCALING  ] {:>8} {:>10} {:>8} {:>10}", "threads", "ops/s", "speedup", "efficiency"));
+        for (const auto& run : scaling) {
+            const double rate = throughput(run);
+            const double speedup = rate / base;
+            const double linear = static_cast<double>(run.first) / static_cast<double>(scaling.front().first);
+            const auto formatted = rate >= 1e9 ? std::format("{:.3g}G", rate / 1e9)
+                : rate >= 1e6 ? std::format("{:.3g}M", rate / 1e6)
+                : rate >= 1e3 ? std::format("{:.3g}k", rate / 1e3) : std::format("{:.3g}", rate);
+            lines.push_back(std::format("[ SCALING  ] {:>8} {:>10} {:>8.2f} {:>9.1f}%", run.first, formatted, speedup, speedup / linear * 100));
+        }
+        return lines;
+    }
+
+    /**
+     * @brief Execute all registered benchmarks (`--benchmark` mode of start())
+     * @param options Benchmark settings
+     * @return The number of failed benchmarks, plus the regressions above
+     *         `options.benchmark_threshold`
+     * @details Benchmarks run serially, one suite after another, and are
+     *          reported to the same reporters as tests, with a
+     *          BenchmarkEndEvent per benchmark and thread count. Unlike in
+     *          test runs, an assertion failure does not stop the remaining
+     *          benchmarks.
+     *
+     *          With a baseline, the samples of each benchmark are compared to
+     *          the baseline samples with a Mann-Whitney U test. Only changes
+     *          significant at the 1% level are flagged as a regression or an
+     *          improvement; the others are reported as no significant change.
+     */
+    int run_benchmarks(const RunOptions& options) {
+        if (options.benchmark_threshold && !(*options.benchmark_threshold >= 0)) {
+            std::println("[  ERROR   ] Invalid benchmark threshold, expected a non-negative percentage");
+            return 1;
+        }
+
+        const auto& bench_suites = get_benchmark_registry();
+        const TimeFormat format{ options.time_unit, measure_timer_overhead() };
+        const auto metric = options.benchmark_metric;
+
+        // The metric counter is read by this thread, which runs all benchmarks
+        std::optional<PerfCounters> metric_counters;
+        BenchmarkMeter meter;
+        if (metric != BenchmarkMetric::Time) {
+            metric_counters.emplace(std::initializer_list<PerfCounter>{
+                metric == BenchmarkMetric::Instructions ? PerfCounter::Instructions : PerfCounter::Cycles
+            });
+            if (metric_counters->counters().empty()) {
+                std::println("[  ERROR   ] Cannot count {} for the benchmarks ({})", metric_name(metric), metric_counters->error());
+                return 1;
+            }
+            meter.read = [&counters = *metric_counters] { return counters.read().values[0]; };
+            meter.counter = metric_counters->counters().front();
+            meter.overhead = measure_meter_overhead(meter.read);
+        }
+
+        BenchmarkBaseline baseline;
+        if (!options.benchmark_compare.empty()) {
+            auto loaded = load_benchmark_baseline(options.benchmark_compare, metric);
+            if (!loaded) {
+                std::println("[  ERROR   ] Cannot read the benchmark baseline {}", options.benchmark_compare);
+                return 1;
+            }
+            baseline = std::move(*loaded);
+        }
+
+        const auto output_reporters = open_output_reporters(options.outputs);
+        if (!output_reporters) return 1;
+        TextReporter text_reporter{ options.time_unit };
+        std::vector<Reporter*> reporters;
+        if (options.text_output) reporters.push_back(&text_reporter);
+        for (const auto& reporter : *output_reporters) reporters.push_back(reporter.get());
+        for (const auto& reporter : get_reporters()) reporters.push_back(reporter.get());
+        EventDispatcher events{ std::move(reporters), options.async_output };
+
+        // Results of this run, written to options.benchmark_out
+        std::vector<std::pair<std::string, BaselineEntry>> results;
+        // Significant regressions above the threshold, with their change in percent
+        std::vector<std::pair<std::string, double>> regressions;
+        // Instance names viewed by the events until they are delivered
+        std::deque<std::string> names;
+
+        std::size_t passed = 0;
+        std::vector<std::string> failures;
+        std::size_t total_benchmarks = 0;
+        const std::size_t total_suites = bench_suites.size();
+        for (const auto& [suite_name, benchmarks] : bench_suites) {
+            for (const auto& bench : benchmarks) total_benchmarks += benchmark_thread_counts(bench.options).size();
+        }
+
+        events.post(RunStartEvent{ total_benchmarks, total_suites, true });
+        const auto total_begin = clock::now();
+
+        for (const auto& [suite_name, benchmarks] : bench_suites) {
+            if (benchmarks.empty()) continue;
+
+            std::size_t suite_benchmarks = 0;
+            for (const auto& bench : benchmarks) suite_benchmarks += benchmark_thread_counts(bench.options).size();
+            events.post(SuiteStartEvent{ suite_name, suite_benchmarks });
+            const auto suite_begin = clock::now();
+
+            for (const auto& bench : benchmarks) {
+                const auto counts = benchmark_thread_counts(bench.options);
+                // Thread count and median time per iteration of each passed run
+                std::vector<std::pair<std::size_t, double>> scaling;
+                for (const std::size_t threads : counts) {
+                    // Keyed on the requested range, not on the core count of this machine
+                    const bool hardware_sized = bench.options.max_threads == 0 && threads == counts.back();
+                    const std::string_view name = names.emplace_back(hardware_sized ? std::format("{}/threads:max", bench.name)
+                        : counts.size() > 1 || threads > 1 ? std::format("{}/threads:{}", bench.name, threads)
+                        : bench.name);
+                    const std::string full_name = std::format("{}.{}", suite_name, name);
+                    events.post(TestStartEvent{ suite_name, name });
+
+                    auto out = run_benchmark(bench, threads, options, format, meter);
+                    BenchmarkEndEvent event{ suite_name, name, std::move(out.result), {}, metric };
+                    event.duration = format.net(event.result.end - event.result.begin);
+                    if (event.result.outcome != TestResult::Outcome::Passed) {
+                        failures.emplace_back(full_name);
+                    } else {
+                        event.iterations = out.iterations;
+                        event.sample_count = out.samples.size();
+                        event.mean = out.stats.mean;
+                        event.median = out.stats.median;
+                        event.stddev = out.stats.stddev;
+                        event.min = out.stats.min;
+                        event.max = out.stats.max;
+                        if (!options.benchmark_compare.empty()) {
+                            if (const auto entry = baseline.find(full_name); entry == baseline.end()) {
+                                event.notes.push_back(std::format("[ BASELINE ] {}  not in the baseline", full_name));
+                            } else {
+                                const auto& base = entry->second;
+                                const double change = base.median > 0 ? (out.stats.median / base.median - 1) * 100 : 0.0;
+                                std::string verdict;
+                                if (base.samples.size() < 2 || out.samples.size() < 2) {
+                                    verdict = "too few samples for a significance test";
+                                } else {
+                                    const double p = mann_whitney_p(out.samples, base.samples);
+                                    const bool significant = p < baseline_significance && out.stats.median != base.median;
+                                    const bool regressed = significant && out.stats.median > base.median;
+                                    verdict = std::format("p = {:.2g}, {}", p,
+                                        !significant ? "no significant change" : regressed ? "regression" : "improvement");
+                                    if (regressed && options.benchmark_threshold && change > *options.benchmark_threshold) {
+                                        regressions.emplace_back(full_name, change);
+                                    }
+                                }
+                                event.notes.push_back(std::format("[ BASELINE ] {}  {:+.2f}% ({} -> {}), {}", full_name, change,
+                                    format_metric(base.median, metric), format_metric(out.stats.median, metric), verdict));
+                            }
+                        }
+                        results.emplace_back(full_name, BaselineEntry{ out.stats.median, out.samples });
+                        if (const auto& latencies = out.latencies; latencies.count() > 0) {
+                            const auto ns = [](const std::uint64_t value) { return format_nanoseconds(static_cast<double>(value)); };
+                            event.notes.push_back(std::format("[ LATENCY  ] {}  (p50 {}, p90 {}, p99 {}, p99.9 {}, max {}; {} values)",
+                                full_name, ns(latencies.percentile(50)), ns(latencies.percentile(90)), ns(latencies.percentile(99)),
+                                ns(latencies.percentile(99.9)), ns(latencies.max()), latencies.count()));
+                        }
+                        if (!out.counters.empty()) {
+                            // Per loop iteration of one thread, including the share of the body's code outside of the loop
+                            const double iterations = static_cast<double>(out.iterations * out.samples.size() * threads);
+                            std::string line = "[ COUNTERS ]";
+                            for (std::size_t i = 0; i < out.counters.size(); ++i) {
+                                std::format_to(std::back_inserter(line), "{} {:.4g} {}", i == 0 ? "" : ",",
+                                    static_cast<double>(out.counters[i].value) / iterations, counter_name(out.counters[i].counter));
+                            }
+                            event.notes.push_back(line + " per iteration");
+                        }
+                        scaling.emplace_back(threads, out.stats.median);
+                        passed++;
+                    }
+                    // The scaling table follows the last thread count
+                    if (threads == counts.back() && counts.size() > 1 && metric == BenchmarkMetric::Time) {
+                        std::ranges::move(scaling_table(suite_name + "." + bench.name, scaling), std::back_inserter(event.notes));
+                    }
+                    events.post(std::move(event));
+                }
+            }
+
+            events.post(SuiteEndEvent{ suite_name, suite_benchmarks, format.net(clock::now() - suite_begin) });
+        }
+
+        RunEndEvent run_end{ total_benchmarks, total_suites, passed, failures, format.net(clock::now() - total_begin) };
+        run_end.regressions = regressions;
+        run_end.regression_threshold = options.benchmark_threshold.value_or(0);
+        events.post(std::move(run_end));
+
+        if (!options.benchmark_out.empty()) {
+            std::ofstream file{ options.benchmark_out };
+            for (const auto& [name, entry] : results) {
+                std::string line = std::format("{} {} {:.9g}", name, metric_name(metric), entry.median);
+                for (const double sample : entry.samples) std::format_to(std::back_inserter(line), " {:.9g}", sample);
+                std::println(file, "{}", line);
+            }
+        }
+
+        return static_cast<int>(failures.size() + regressions.size());
+    }
+
+
+    /**
+     * @brief Two-sided standard normal quantile of a confidence level
+     * @param confidence e.g. 0.95
+     * @return z such that P(|Z| <= z) = confidence, e.g. 1.96
+     */
+    double normal_quantile(const double confidence) {
+        double low = 0, high = 10;
+        for (int i = 0; i < 64; ++i) {
+            const double mid = (low + high) / 2;
+            (std::erf(mid / std::numbers::sqrt2) < confidence ? low : high) = mid;
+        }
+        return (low + high) / 2;
+    }
+
+    /**
+     * @struct PercentileEstimate
+     * @brief A sample percentile with its distribution-free confidence interval
+     */
+    struct PercentileEstimate {
+        double value{};
+        double lower{};
+        double upper{};
+        bool bounded{ false };          ///< Whether both bounds fall within the samples, so the interval holds
+
+        /// Width of the interval relative to the estimate
+        double relative_width() const noexcept {
+            return value > 0 ? (upper - lower) / value : 0.0;
+        }
+    };
+
+    /**
+     * @brief Estimate a percentile and its confidence interval
+     * @param samples The measurements, sorted in place
+     * @param percentile Percentile in (0, 100), 50 for the median
+     * @param z Normal quantile of the confidence level
+     * @details The interval bounds are order statistics whose ranks come from
+     *          the normal approximation of the binomial distribution, so no
+     *          assumption is made about the distribution of the samples.
+     */
+    PercentileEstimate estimate_percentile(std::span<double> samples, const double percentile, const double z) {
+        PercentileEstimate estimate;
+        if (samples.empty()) return estimate;
+
+        std::ranges::sort(samples);
+        const double n = static_cast<double>(samples.size());
+        const double q = percentile / 100;
+        const double position = q * (n - 1);
+        const auto below = static_cast<std::size_t>(position);
+        const auto above = std::min(below + 1, samples.size() - 1);
+        estimate.value = samples[below] + (samples[above] - samples[below]) * (position - static_cast<double>(below));
+
+        const double spread = z * std::sqrt(n * q * (1 - q));
+        const auto rank = [&](const double r) {
+            return static_cast<std::size_t>(std::clamp(r, 0.0, n - 1));
+        };
+        const double lower_rank = std::floor(n * q - spread) - 1;
+        const double upper_rank = std::ceil(n * q + spread);
+        estimate.lower = samples[rank(lower_rank)];
+        estimate.upper = samples[rank(upper_rank)];
+        estimate.bounded = lower_rank >= 0 && upper_rank <= n - 1;
+        return estimate;
+    }
+
+    /// Runs a checked statement a given number of times
+    using RepeatedStatement = std::function<void(std::size_t)>;
+
+    /// Time one batch of runs, in nanoseconds per run
+    double time_batch(const RepeatedStatement& statement, const std::size_t runs) {
+        const auto begin = clock::now();
+        statement(runs);
+        const auto elapsed = std::chrono::duration<double, std::nano>(clock::now() - begin);
+        return elapsed.count() / static_cast<double>(runs);
+    }
+
+    /**
+     * @brief Find the number of runs per batch whose time lasts at least `target`
+     * @details Same growth strategy as calibrate_iterations(); the last
+     *          calibration batch doubles as warmup.
+     */
+    std::size_t calibrate_batch(const RepeatedStatement& statement, const clock::duration target) {
+        constexpr std::size_t max_runs = 1'000'000'000;
+        const double target_ns = std::chrono::duration<double, std::nano>(target).count();
+        std::size_t runs = 1;
+        while (true) {
+            const double elapsed = time_batch(statement, runs) * static_cast<double>(runs);
+            if (elapsed >= target_ns || runs >= max_runs) return runs;
+            const double growth = std::clamp(elapsed > 0 ? target_ns / elapsed * 1.2 : 10.0, 2.0, 10.0);
+            runs = std::min(static_cast<std::size_t>(static_cast<double>(runs) * growth), max_runs);
+        }
+    }
+
+    /**
+     * @brief Measure the per-run cost of timing a batch, beyond the statement itself
+     * @param runs Number of runs per batch, as calibrated for the checked statement
+     * @return Nanoseconds per run to subtract from each sample
+     * @details The sum of the clock overhead, spread over the batch, and of
+     *          the median time of an empty statement, whose batches pay the
+     *          same std::function call and loop as the checked statement.
+     */
+    double measure_batch_overhead(const std::size_t runs) {
+        constexpr std::size_t samples = 31;
+        const RepeatedStatement empty = [](const std::size_t count) {
+            for (std::size_t run = 0; run < count; ++run) std::atomic_signal_fence(std::memory_order_seq_cst);
+            ClobberMemory();
+        };
+        const double timer = std::chrono::duration<double, std::nano>(measure_timer_overhead()).count()
+            / static_cast<double>(runs);
+        std::array<double, samples> calls;
+        for (auto& call : calls) call = std::max(0.0, time_batch(empty, runs) - timer);
+        std::ranges::nth_element(calls, calls.begin() + samples / 2);
+        return timer + calls[samples / 2];
+    }
+
+    /// Time one batch of runs corrected for the measurement overhead, in nanoseconds per run
+    double time_corrected_batch(const RepeatedStatement& statement, const std::size_t runs, const double overhead) {
+        return std::max(0.0, time_batch(statement, runs) - overhead);
+    }
+
+    /// e.g. "median", "p99", "p99.9"
+    std::string percentile_name(const double percentile) {
+        return percentile == 50 ? std::string{ "median" } : std::format("p{}", percentile);
+    }
+
+}
+
+
+export namespace vct::test::unit {
+
+    /**
+     * @struct TimingOptions
+     * @brief Sampling policy of the performance assertions
+     * @details Statements are run in batches of at least `sample_time`, one
+     *          sample per batch, until the confidence interval of the checked
+     *          percentile is narrower than `precision` (relative to the
+     *          estimate) or lies entirely on one side of the budget, but at
+     *          least `min_samples` and at most `max_samples` times or `max_time`.
+     */
+    struct TimingOptions {
+        double confidence{ 0.95 };                          ///< Confidence level of the interval
+        double precision{ 0.05 };                           ///< Relative width at which sampling stops
+        std::size_t min_samples{ 20 };
+        std::size_t max_samples{ 2000 };
+        std::chrono::microseconds sample_time{ 100 };       ///< Minimum duration of one sample batch
+        std::chrono::milliseconds max_time{ 1000 };         ///< Sampling time limit per statement
+    };
+
+    /**
+     * @brief Get the global sampling policy of the performance assertions
+     * @return Mutable reference, e.g. to relax the limits in a global Environment
+     */
+    TimingOptions& get_timing_options() {
+        static TimingOptions options;
+        return options;
+    }
+
+    /**
+     * @struct TimeBudget
+     * @brief Time limit of M_EXPECT_FASTER_THAN for one run of a statement
+     * @details Implicitly constructible from any duration, which checks the
+     *          median; pass e.g. `TimeBudget(2ms, 99)` to check the 99th
+     *          percentile instead.
+     */
+    struct TimeBudget {
+        std::chrono::nanoseconds limit{};
+        double percentile{ 50 };            ///< Checked percentile in (0, 100)
+
+        template<typename Rep, typename Period>
+        TimeBudget(const std::chrono::duration<Rep, Period> limit, const double percentile = 50)
+            : limit(std::chrono::duration_cast<std::chrono::nanoseconds>(limit)), percentile(percentile) {}
+    };
+
+    /**
+     * @brief Check that a statement runs within a time budget
+     * @param budget The limit and the percentile checked against it
+     * @param statement Runs the checked statement the given number of times
+     * @param text Source text of the checked statement
+     * @return The failure message, or std::nullopt if the budget holds
+     * @details Used by M_EXPECT_FASTER_THAN. The result is decided on the
+     *          percentile estimate; its confidence interval is reported.
+     *          Samples exclude the clock and empty-call overhead.
+     */
+    std::optional<std::string> check_faster_than(
+        const TimeBudget& budget, const detail::RepeatedStatement& statement, const std::string_view text
+    ) {
+        const auto& options = get_timing_options();
+        if (!(budget.percentile > 0 && budget.percentile < 100)) {
+            return std::format("Invalid percentile {} for {}, expected a value in (0, 100)", budget.percentile, text);
+        }
+        const double z = detail::normal_quantile(options.confidence);
+        const double limit = static_cast<double>(budget.limit.count());
+        const std::size_t runs = detail::calibrate_batch(statement, options.sample_time);
+        const double overhead = detail::measure_batch_overhead(runs);
+        const auto deadline = detail::clock::now() + options.max_time;
+
+        std::vector<double> samples;
+        std::vector<double> sorted;
+        detail::PercentileEstimate estimate;
+        std::size_t next_check = options.min_samples;
+        bool settled = false;
+        while (true) {
+            samples.push_back(detail::time_corrected_batch(statement, runs, overhead));
+            const bool exhausted = samples.size() >= options.max_samples || detail::clock::now() >= deadline;
+            if (samples.size() < next_check && !exhausted) continue;
+
+            sorted = samples;
+            estimate = detail::estimate_percentile(sorted, budget.percentile, z);
+            settled = estimate.bounded && (
+                estimate.relative_width() <= options.precision || estimate.upper <= limit || estimate.lower > limit
+            );
+            if (settled || exhausted) break;
+            next_check = samples.size() + std::max<std::size_t>(1, samples.size() / 8);
+        }
+        if (estimate.value <= limit) return std::nullopt;
+
+        auto message = std::format("Expected: {} of {} within {}\nActual: {} ({:g}% CI {} .. {}, {} samples x {} run{})",
+            detail::percentile_name(budget.percentile), text, detail::format_nanoseconds(limit),
+            detail::format_nanoseconds(estimate.value), options.confidence * 100,
+            detail::format_nanoseconds(estimate.lower), detail::format_nanoseconds(estimate.upper),
+            samples.size(), runs, runs != 1 ? "s" : "");
+        if (!settled) message += "\nThe interval did not reach the requested precision within the sampling limits";
+        return message;
+    }
+
+    /**
+     * @brief Check that one statement is faster than another by a factor
+     * @param first Runs the statement expected to be faster
+     * @param second Runs the reference statement
+     * @param ratio Highest allowed ratio of the median times, e.g. 0.8
+     * @param first_text Source text of the first statement
+     * @param second_text Source text of the second statement
+     * @return The failure message, or std::nullopt if the ratio holds
+     * @details Used by M_EXPECT_FASTER. Batches of both statements are
+     *          interleaved, so that frequency changes and background load
+     *          affect both alike. The interval of the ratio is derived from
+     *          the intervals of both medians. Samples exclude the clock and
+     *          empty-call overhead, so that it does not pull the ratio to 1.
+     */
+    std::optional<std::string> check_faster(
+        const detail::RepeatedStatement& first, const detail::RepeatedStatement& second, const double ratio,
+        const std::string_view first_text, const std::string_view second_text
+    ) {
+        const auto& options = get_timing_options();
+        const double z = detail::normal_quantile(options.confidence);
+        const std::size_t first_runs = detail::calibrate_batch(first, options.sample_time);
+        const std::size_t second_runs = detail::calibrate_batch(second, options.sample_time);
+        const double first_overhead = detail::measure_batch_overhead(first_runs);
+        const double second_overhead = detail::measure_batch_overhead(second_runs);
+        const auto deadline = detail::clock::now() + 2 * options.max_time;
+
+        std::vector<double> first_samples, second_samples;
+        std::vector<double> sorted;
+        detail::PercentileEstimate first_estimate, second_estimate;
+        double actual{}, lower{}, upper{};
+        std::size_t next_check = options.min_samples;
+        bool settled = false;
+        while (true) {
+            first_samples.push_back(detail::time_corrected_batch(first, first_runs, first_overhead));
+            second_samples.push_back(detail::time_corrected_batch(second, second_runs, second_overhead));
+            const std::size_t n = first_samples.size();
+            const bool exhausted = n >= options.max_samples || detail::clock::now() >= deadline;
+            if (n < next_check && !exhausted) continue;
+
+            sorted = first_samples;
+            first_estimate = detail::estimate_percentile(sorted, 50, z);
+            sorted = second_samples;
+            second_estimate = detail::estimate_percentile(sorted, 50, z);
+            if (second_estimate.value > 0) {
+                actual = first_estimate.value / second_estimate.value;
+                lower = first_estimate.lower / second_estimate.upper;
+                upper = second_estimate.lower > 0
+                    ? first_estimate.upper / second_estimate.lower
+                    : std::numeric_limits<double>::infinity();
+                settled = first_estimate.bounded && second_estimate.bounded && (
+                    (upper - lower) / actual <= 2 * options.precision || upper <= ratio || lower > ratio
+                );
+            }
+            if (settled || exhausted) break;
+            next_check = n + std::max<std::size_t>(1, n / 8);
+        }
+        if (second_estimate.value <= 0) {
+            return std::format("Expected: {} to take at most {:g}x the time of {}\n"
+                "Actual: {} is not measurably slower than an empty statement, {} samples",
+                first_text, ratio, second_text, second_text, first_samples.size());
+        }
+        if (actual <= ratio) return std::nullopt;
+
+        auto message = std::format("Expected: {} to take at most {:g}x the time of {}\n"
+            "Actual: {:.3g}x ({:g}% CI {:.3g}x .. {:.3g}x), median {} vs {}, {} samples",
+            first_text, ratio, second_text, actual, options.confidence * 100, lower, upper,
+            detail::format_nanoseconds(first_estimate.value), detail::format_nanoseconds(second_estimate.value),
+            first_samples.size());
+        if (!settled) message += "\nThe interval did not reach the requested precision within the sampling limits";
+        return message;
+    }
+
+    /**
+     * @brief Register the bounds of the `vct_test_unit` linker section
+     * @param first Start of the descriptor pointer array (`__start_vct_test_unit`)
+     * @param last End of the descriptor pointer array (`__stop_vct_test_unit`)
+     * @details Called once during static initialization by the macros header
+     *          when VCT_TEST_UNIT_SECTION_REGISTRATION is defined. The section
+     *          symbols are resolved in the test executable, so this works for
+     *          both static and shared builds of the library.
+     */
+    void set_test_section(const TestDescriptor* const* first, const TestDescriptor* const* last) noexcept {
+        if (first == nullptr || last == nullptr || last < first) return;
+        detail::section_first = first;
+        detail::section_last = last;
+    }
+
+    /**
+     * @brief Start and execute all registered tests
+     * @param options Options controlling the test run
+     * @return The number of failed tests (0 if all tests passed)
+     * @details Executes all test cases registered in the global test registry.
+     *          Provides GTest-compatible output formatting with detailed timing
+     *          information and comprehensive failure reporting.
+     * 
+     * Test execution flow:
+     * 1. Enumerate all registered test suites and cases
+     * 2. Execute each test case with precise timing measurement
+     * 3. Handle different exception types (Assert, Expect, Unknown)
+     * 4. Generate detailed reports with pass/fail statistics
+     * 
+     * When `options.jobs` is not 1, test cases are executed on a work-stealing
+     * thread pool. Results are still printed in registry order, so the output
+     * has the same shape as a serial run. Suites registered with
+     * M_TEST_SUITE_SERIAL are run one test at a time once the parallel part
+     * has drained, and reported at their place in the registry order.
+     * 
+     * When `options.isolate` is set (POSIX only), tests run in pre-forked
+     * worker processes instead of threads. A test that crashes its worker
+     * (signal, abort, exit) is reported as failed with the cause, and a new
+     * worker replaces the dead one, so the rest of the run is unaffected.
+     * 
+     * With `options.zygote` = B > 0 (POSIX only), the global environments
+     * and each suite's SetUpTestSuite() run once in the runner process, and
+     * every batch of B tests runs in a process forked from that prepared
+     * state. Tests get copy-on-write isolation from each other without
+     * paying for the setup again.
+     * 
+     * Tests overrunning their timeout (TestOptions::timeout, or
+     * `options.timeout` as default) are detected by a watchdog: in-process
+     * runs print the hung test with a stack trace of its thread and abort;
+     * isolated runs kill the worker, report a timeout and continue.
+     * `options.global_timeout` bounds the whole run: in-process runs abort
+     * when it expires, isolated runs report their busy tests as timed out
+     * and stop.
+     * 
+     * With `options.shard_count > 1`, only one deterministic slice of the
+     * flattened tests is run, dealt round-robin or balanced by the historical
+     * durations in `options.shard_durations`.
+     * 
+     * Each instance of a parameterized test (M_TEST_P) is reported as a test
+     * of its own, named "Name/index". Instances are generated while the test
+     * runs, so counts announced at the start treat a parameterized test as
+     * one test. With `jobs` > 1 or in worker processes, all instances of one
+     * parameterized test run as a single task.
+     * 
+     * When `options.benchmark` is set, the registered benchmarks are run
+     * instead of the tests (see M_BENCHMARK).
+     * 
+     * Progress is reported as events to the TextReporter and to the
+     * reporters of get_reporters(). By default they are called on a
+     * background thread, so slow output does not delay the tests; use
+     * `options.async_output = false` when tests print to stdout themselves
+     * and their output must stay between the RUN and OK lines. Runs with
+     * `options.isolate` or `options.zygote` always report synchronously, since the runner only
+     * collects results there and a reporter thread writing to stdout while
+     * a worker is forked would duplicate or deadlock its output.
+     * 
+     * Output format matches Google Test for compatibility with CI/CD systems.
+     * 
+     * @note This function is typically called from main() in test executables
+     * @see get_test_registry() for the underlying test storage mechanism
+     */
+    int start(const RunOptions& options) {
+        using detail::clock;
+
+        if (options.perf_counters) {
+            const auto& counters = detail::PerfCounters::local();
+            if (counters.counters().empty()) {
+                std::println("[ WARNING  ] Performance counters are not available ({}), running without them", counters.error());
+            } else {
+                if (counters.software_only()) {
+                    std::println("[ WARNING  ] Hardware performance counters are not available, using software counters");
+                }
+                detail::perf_counters_enabled.store(true, std::memory_order_relaxed);
+            }
+        }
+
+        if (options.benchmark) return detail::run_benchmarks(options);
+
+        detail::capture_allocation_stacks.store(options.allocation_stacks, std::memory_order_relaxed);
+
+        if (options.shard_count == 0 || options.shard_index >= options.shard_count) {
+            std::println("[  ERROR   ] Invalid shard {} of {}", options.shard_index, options.shard_count);
+            return 1;
+        }
+        if (options.shard_count > 1) {
+            // Tell GTest-aware runners that sharding is supported
+            if (const char* status_file = std::getenv("GTEST_SHARD_STATUS_FILE")) std::ofstream{ status_file };
+        }
+
+        // Get all registered test suites and cases, ordered by suite, and keep this shard's part
+        auto plan = detail::select_shard(
+            detail::flatten_tests(detail::TestFilter{ options.filter }), options.shard_index, options.shard_count,
+            options.shard_durations.empty() ? detail::DurationMap{} : detail::load_durations(options.shard_durations)
+        );
+        const auto& serial_suites = get_serial_suites();
+
+        // List the selected tests in GTest format with a single write
+        if (options.list) {
+            std::string listing;
+            for (std::size_t i = 0; i < plan.size(); ++i) {
+                if (i == 0 || plan[i].suite != plan[i - 1].suite) std::format_to(std::back_inserter(listing), "{}.\n", plan[i].suite);
+                std::format_to(std::back_inserter(listing), "  {}\n", plan[i].name);
+            }
+            std::print("{}", listing);
+            return 0;
+        }
+
+        // Test execution statistics
+        std::size_t passed = 0;                    ///< Number of tests that passed
+        std::vector<std::string> failures;         ///< Names of failed tests
+        std::size_t total_tests = plan.size();     ///< Total number of test cases
+        std::size_t executed = 0;                  ///< Reported tests, counting each parameter instance
+        std::size_t total_suites = 0;              ///< Total number of test suites
+
+        // Count distinct suites, the plan is grouped by suite name
+        for (std::size_t i = 0; i < plan.size(); ++i) {
+            if (i == 0 || plan[i].suite != plan[i - 1].suite) ++total_suites;
+        }
+
+        const std::size_t jobs = options.jobs == 0
+            ? std::max<std::size_t>(std::thread::hardware_concurrency(), 1)
+            : options.jobs;
+
+        // Parallel-safe tests are scheduled first and serial suites after them,
+        // while the plan keeps the order in which everything is reported
+        std::vector<std::size_t> parallel_tasks, serial_tasks;
+        std::vector<bool> in_parallel(plan.size(), false);
+        if (jobs > 1) {
+            for (std::size_t index = 0; index < plan.size(); ++index) {
+                const bool serial = serial_suites.contains(plan[index].suite);
+                (serial ? serial_tasks : parallel_tasks).push_back(index);
+                in_parallel[index] = !serial;
+            }
+        }
+
+        // Reported durations exclude the cost of reading the clock
+        const detail::TimeFormat format{ options.time_unit, detail::measure_timer_overhead() };
+
+        if ((options.isolate || options.zygote > 0) && !detail::process_isolation_supported) {
+            std::println("[ WARNING  ] Process isolation is not supported on this platform, running in-process");
+        }
+
+        // Result files requested with --output
+        const auto output_reporters = detail::open_output_reporters(options.outputs);
+        if (!output_reporters) return 1;
+
+        // All output goes through the reporters, off the test thread unless disabled.
+        // fork() must not copy a reporter thread's half-written stdio buffers or locks.
+        const bool forks_workers = (options.isolate || options.zygote > 0) && detail::process_isolation_supported;
+        TextReporter text_reporter{ options.time_unit };
+        std::vector<Reporter*> reporters;
+        if (options.text_output) reporters.push_back(&text_reporter);
+        for (const auto& reporter : *output_reporters) reporters.push_back(reporter.get());
+        for (const auto& reporter : get_reporters()) reporters.push_back(reporter.get());
+        detail::EventDispatcher events{ std::move(reporters), options.async_output && !forks_workers };
+
+        events.post(RunStartEvent{ total_tests, total_suites });
+        const auto total_begin = clock::now();
+        const auto run_deadline = options.global_timeout > std::chrono::milliseconds::zero()
+            ? total_begin + options.global_timeout
+            : clock::time_point::max();
+
+        // Global environments, also inherited by worker processes forked later
+        detail::Environments environments;
+        if (const auto error = environments.set_up()) {
+            events.post(RunEndEvent{ total_tests, total_suites, 0, {}, format.net(clock::now() - total_begin), true });
+            events.flush();
+            std::println("[  ERROR   ] Global test environment set-up failed: {}", *error);
+            return 1;
+        }
+
+        // Suite bookkeeping of the ordered output
+        std::optional<std::string_view> current_suite;
+        std::size_t suite_executed = 0;
+        clock::time_point suite_begin{}, suite_end{};
+
+        const auto end_suite = [&] {
+            if (!current_suite) return;
+            events.post(SuiteEndEvent{ *current_suite, suite_executed, format.net(suite_end - suite_begin) });
+            current_suite.reset();
+        };
+
+        // Report the suite start if needed and the start of plan[index] or one of its instances
+        const auto begin_test = [&](const std::size_t index, const clock::time_point begin, const std::optional<std::size_t> param_index = {}) {
+            const auto& test = plan[index];
+            if (current_suite != test.suite) {
+                end_suite();
+                current_suite = test.suite;
+                suite_executed = 0;
+                std::size_t suite_count = 0;
+                for (std::size_t i = index; i < plan.size() && plan[i].suite == test.suite; ++i) ++suite_count;
+                events.post(SuiteStartEvent{ test.suite, suite_count });
+                suite_begin = begin;
+                suite_end = begin;
+            }
+            events.post(TestStartEvent{ test.suite, test.name, param_index });
+        };
+
+        // Durations of this run, written to options.record_durations
+        std::vector<std::pair<std::string, double>> durations;
+        const auto write_durations = [&] {
+            if (options.record_durations.empty()) return;
+            std::ofstream file{ options.record_durations };
+            for (const auto& [name, ms] : durations) std::println(file, "{} {:.3f}", name, ms);
+        };
+
+        // Report the outcome of plan[index] or one of its instances; returns false if the run must stop
+        const auto finish_test = [&](const std::size_t index, TestResult&& result) {
+            const auto& test = plan[index];
+            const auto outcome = result.outcome;
+            const auto name = detail::instance_name(test.name, result.param_index);
+            const auto duration = format.net(result.end - result.begin);
+            if (!options.record_durations.empty()) {
+                durations.emplace_back(
+                    std::format("{}.{}", test.suite, name),
+                    std::chrono::duration<double, std::milli>(duration).count()
+                );
+            }
+            suite_begin = std::min(suite_begin, result.begin);
+            suite_end = std::max(suite_end, result.end);
+            ++executed;
+            ++suite_executed;
+            events.post(TestEndEvent{ test.suite, test.name, std::move(result), duration });
+
+            switch (outcome) {
+            case TestResult::Outcome::Passed:
+                passed++;
+                return true;
+            case TestResult::Outcome::Assert:
+                // Assertion failure - terminate test execution
+                return false;
+            default:
+                // Expectation failure, unknown exception or crash - continue with next test
+                failures.emplace_back(std::format("{}.{}", test.suite, name));
+                return true;
+            }
+        };
+
+        // Report the start and outcome of a test that has already run
+        const auto report_test = [&](const std::size_t index, TestResult&& result) {
+            begin_test(index, result.begin, result.param_index);
+            return finish_test(index, std::move(result));
+        };
+
+        // Ends the output after an assertion failure, keeping the durations measured so far
+        const auto abort_run = [&] {
+            write_durations();
+            events.post(RunEndEvent{ executed, total_suites, passed, std::move(failures), format.net(clock::now() - total_begin), true });
+            if (clock::now() >= run_deadline) {
+                events.flush();
+                std::println("[ TIMEOUT  ] Global timeout of {} ms expired, aborting the run", options.global_timeout.count());
+            }
+            return static_cast<int>(std::max(total_tests, executed) - passed);
+        };
+
+        if (options.isolate || options.zygote > 0) {
+#if defined(_M_VCT_TEST_UNIT_POSIX)
+            // Results arrive in completion order and are reported in plan order
+            std::vector<std::optional<std::vector<TestResult>>> pending(plan.size());
+            std::size_t next_print = 0;
+            const auto on_result = [&](const std::size_t index, std::vector<TestResult>&& results) {
+                pending[index] = std::move(results);
+                for (; next_print < plan.size() && pending[next_print]; ++next_print) {
+                    auto ready = std::move(*pending[next_print]);
+                    pending[next_print].reset();
+                    for (auto& result : ready) {
+                        if (!report_test(next_print, std::move(result))) return false;
+                    }
+                }
+                return true;
+            };
+
+            if (options.zygote > 0) {
+                // Suite by suite: set up in the runner, then run the tests in
+                // processes forked from that state, a fresh one per batch
+                for (std::size_t first = 0, last = 0; first < plan.size(); first = last) {
+                    if (clock::now() >= run_deadline) return abort_run();
+                    const auto suite = plan[first].suite;
+                    while (last < plan.size() && plan[last].suite == suite) ++last;
+                    const auto hooks = plan[first].hooks;
+
+                    const auto set_up = hooks.set_up != nullptr ? detail::run_guarded(hooks.set_up) : TestResult{};
+                    if (set_up.outcome != TestResult::Outcome::Passed) {
+                        for (std::size_t index = first; index < last; ++index) {
+                            std::vector<TestResult> results;
+                            results.push_back(detail::suite_set_up_failure(set_up, suite));
+                            if (!on_result(index, std::move(results))) return abort_run();
+                        }
+                        continue;
+                    }
+
+                    // The last test of the suite is held back to carry TearDownTestSuite() failures
+                    std::optional<std::vector<TestResult>> last_results;
+                    const auto on_suite_result = [&](const std::size_t index, std::vector<TestResult>&& results) {
+                        if (index + 1 < last) return on_result(index, std::move(results));
+                        last_results = std::move(results);
+                        return true;
+                    };
+                    const std::size_t workers = serial_suites.contains(suite) ? 1 : std::min(jobs, last - first);
+                    detail::ProcessPool processes{ plan, workers, options.timeout, run_deadline, options.zygote };
+                    const bool proceed = processes.run(first, last, on_suite_result);
+                    processes.shutdown();
+
+                    auto tear_down = hooks.tear_down != nullptr ? detail::run_guarded(hooks.tear_down) : TestResult{};
+                    if (!proceed) return abort_run();
+                    if (last_results) {
+                        // Like in-process runs, a parameterized test keeps its instances' outcomes
+                        if (tear_down.outcome != TestResult::Outcome::Passed && (plan[last - 1].params != nullptr || last_results->empty())) {
+                            TestResult result;
+                            result.begin = result.end = clock::now();
+                            last_results->push_back(std::move(result));
+                        }
+                        if (!last_results->empty()) detail::merge_suite_tear_down(last_results->back(), std::move(tear_down), suite);
+                        if (!on_result(last - 1, std::move(*last_results))) return abort_run();
+                    }
+                }
+            } else {
+                // Serial suites (only split off when jobs > 1) get a single worker of their own
+                // once the others are done; on_result holds back results until their turn
+                if (jobs == 1) {
+                    parallel_tasks.resize(plan.size());
+                    std::iota(parallel_tasks.begin(), parallel_tasks.end(), std::size_t{ 0 });
+                }
+                detail::ProcessPool processes{ plan, std::min(jobs, std::max<std::size_t>(parallel_tasks.size(), 1)), options.timeout, run_deadline };
+                if (!processes.run(parallel_tasks, on_result)) {
+                    return abort_run();
+                }
+                processes.shutdown();
+                if (!serial_tasks.empty()) {
+                    detail::ProcessPool serial_process{ plan, 1, options.timeout, run_deadline };
+                    if (!serial_process.run(serial_tasks, on_result)) {
+                        return abort_run();
+                    }
+                }
+            }
+#endif
+        }
+
+        if ((!options.isolate && options.zygote == 0) || !detail::process_isolation_supported) {
+            // Aborts the run if a test overruns its timeout or the run its global timeout, after the output so far
+            detail::Watchdog watchdog{ [&] { events.flush(); } };
+            watchdog.limit_run(total_begin, options.global_timeout);
+            // Outlives the worker pool, so suites left set up by an aborted run are torn down last
+            detail::SuiteFixtures fixtures{ plan };
+            const auto execute = [&](const std::size_t index, const detail::ResultSink& sink) {
+                const auto& test = plan[index];
+                const auto timeout = test.options.timeout > std::chrono::milliseconds::zero() ? test.options.timeout : options.timeout;
+                auto guard = watchdog.watch(test, timeout);
+                return fixtures.run(index, { [&](const std::size_t param_index) {
+                    guard.restart(param_index);
+                    if (sink.on_instance) sink.on_instance(param_index);
+                }, sink.on_result });
+            };
+
+            // Results of tests executed by the worker pool, indexed like `plan`
+            std::vector<std::optional<std::vector<TestResult>>> results(plan.size());
+            std::mutex results_mutex;
+            std::condition_variable results_ready;
+            std::size_t workers_running = 0;
+
+            std::optional<detail::WorkStealingPool> pool;
+            if (!parallel_tasks.empty()) {
+                pool.emplace(std::min(jobs, parallel_tasks.size()), parallel_tasks.size());
+                workers_running = pool->size();
+                pool->launch(
+                    [&](const std::size_t task) {
+                        const std::size_t index = parallel_tasks[task];
+                        std::vector<TestResult> collected;
+                        const bool proceed = execute(index, { {}, [&](TestResult&& result) {
+                            collected.push_back(std::move(result));
+                            return collected.back().outcome != TestResult::Outcome::Assert;
+                        } });
+                        if (!proceed) pool->request_stop();
+                        {
+                            std::lock_guard lock{ results_mutex };
+                            results[index] = std::move(collected);
+                        }
+                        results_ready.notify_all();
+                    },
+                    [&] {
+                        {
+                            std::lock_guard lock{ results_mutex };
+                            --workers_running;
+                        }
+                        results_ready.notify_all();
+                    }
+                );
+            }
+
+            // Walk the plan in order. Tests of the parallel part are waited
+            // for, the rest run inline once the pool has drained.
+            for (std::size_t index = 0; index < plan.size(); ++index) {
+                bool proceed = true;
+                if (in_parallel[index]) {
+                    std::unique_lock lock{ results_mutex };
+                    results_ready.wait(lock, [&] { return results[index].has_value() || workers_running == 0; });
+                    // Skipped because the pool was stopped by an assertion failure
+                    if (!results[index]) continue;
+                    auto finished = std::move(*results[index]);
+                    lock.unlock();
+                    for (auto& result : finished) {
+                        if (!(proceed = report_test(index, std::move(result)))) break;
+                    }
+                } else {
+                    // Serial tests never overlap with the parallel part, whose
+                    // remaining results are all available after the join
+                    if (pool) pool->join();
+                    // Instances are reported while the test runs, each starting right before it runs
+                    const bool parameterized = plan[index].params != nullptr;
+                    if (!parameterized) begin_test(index, clock::now());
+                    proceed = execute(index, {
+                        [&](const std::size_t param_index) { begin_test(index, clock::now(), param_index); },
+                        [&](TestResult&& result) {
+                            if (parameterized && !result.param_index) begin_test(index, result.begin);
+                            return finish_test(index, std::move(result));
+                        }
+                    });
+                }
+
+                if (!proceed) {
+                    if (pool) {
+                        pool->request_stop();
+                        pool->join();
+                    }
+                    return abort_run();
+                }
+            }
+            if (pool) pool->join();
+        }
+        end_suite();
+        write_durations();
+
+        const auto tear_down_error = environments.tear_down();
+
+        // Report the final summary; the dispatcher delivers it before start() returns
+        const auto failed = static_cast<int>(failures.size());
+        events.post(RunEndEvent{ executed, total_suites, passed, std::move(failures), format.net(clock::now() - total_begin) });
+        if (tear_down_error) {
+            events.flush();
+            std::println("[  ERROR   ] Global test environment tear-down failed: {}", *tear_down_error);
+            return std::max(failed, 1);
+        }
+
+        // Return the number of failed tests (0 = success, >0 = failure count)
+        return failed;
+    }
+
+    /**
+     * @brief Parse the command line and execute all registered tests
+     * @param argc Argument count as passed to main()
+     * @param argv Argument vector as passed to main()
+     * @return The number of failed tests (0 if all tests passed)
+     * @see parse_options() for the recognized arguments
+     */
+    int start(const int argc, const char* const argv[]) {
+        return start(parse_options(argc, argv));
+    }
+
+    /**
+     * @brief Start and execute all registered tests serially
+     * @return The number of failed tests (0 if all tests passed)
+     */
+    int start() {
+        return start(RunOptions{});
     }
 
 }
@@ -0,0 +1,81 @@
+/**
+ * @file allocation_test.cpp
+ * @brief Tests of the allocation counting behind M_EXPECT_NO_ALLOC and M_EXPECT_MAX_ALLOCS
+ * @details Installs the counting allocation hooks for the whole test
+ *          program, so this is the only file defining
+ *          VCT_TEST_UNIT_ALLOCATION_HOOKS. The hooks use the standard library,
+ *          which is therefore imported before the macros header. Allocations
+ *          are passed to DoNotOptimize, since new/delete pairs may be elided.
+ */
+import std;
+import vct.test.unit;
+
+#define VCT_TEST_UNIT_ALLOCATION_HOOKS
+#include <vct/test_unit_macros.hpp>
+
+namespace {
+    using vct::test::unit::AllocationScope;
+    using vct::test::unit::DoNotOptimize;
+
+    /// Allocate `size` bytes and free them again
+    void allocate(const std::size_t size) {
+        auto memory = std::make_unique<char[]>(size);
+        DoNotOptimize(memory.get());
+    }
+}
+
+M_TEST(Allocation, CountsAllocationsOfTheThread) {
+    AllocationScope scope;
+    allocate(16);
+    allocate(400);
+    scope.stop();
+    allocate(8);
+    M_EXPECT_EQ(scope.count(), 2u);
+    M_EXPECT_EQ(scope.bytes(), 416u);
+}
+
+M_TEST(Allocation, ReportsCountAndSizes) {
+    AllocationScope scope;
+    allocate(64);
+    allocate(32);
+    const auto failure = scope.check(1, "statement");
+    M_ASSERT_TRUE(failure.has_value());
+    M_EXPECT_TRUE(failure->contains("Expected: at most 1 allocation in statement"));
+    M_EXPECT_TRUE(failure->contains("Actual: 2 allocations of 96 bytes in total, the first of 64 bytes"));
+
+    AllocationScope quiet;
+    M_EXPECT_FALSE(quiet.check(0, "nothing").has_value());
+}
+
+M_TEST(Allocation, NestedScopesBothCount) {
+    AllocationScope outer;
+    {
+        AllocationScope inner;
+        allocate(10);
+        M_EXPECT_EQ(inner.count(), 1u);
+    }
+    allocate(20);
+    M_EXPECT_EQ(outer.count(), 2u);
+    M_EXPECT_EQ(outer.bytes(), 30u);
+}
+
+M_TEST(Allocation, OtherThreadsAreNotCounted) {
+    // The thread is started before the scope, since starting it allocates
+    std::latch start{ 1 }, done{ 1 };
+    std::jthread other{ [&] {
+        start.wait();
+        allocate(100);
+        done.count_down();
+    } };
+    AllocationScope scope;
+    start.count_down();
+    done.wait();
+    scope.stop();
+    M_EXPECT_EQ(scope.count(), 0u);
+}
+
+M_TEST(Allocation, MacrosCheckTheLimit) {
+    M_EXPECT_NO_ALLOC(int value = 42; DoNotOptimize(value));
+    M_EXPECT_MAX_ALLOCS(2, allocate(1); allocate(2));
+    M_ASSERT_MAX_ALLOCS(1, allocate(3));
+}
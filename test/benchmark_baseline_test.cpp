@@ -0,0 +1,129 @@
+/**
+ * @file benchmark_baseline_test.cpp
+ * @brief Tests of the comparison of benchmarks against a stored baseline
+ * @details mann_whitney_p() and load_benchmark_baseline() are internal to
+ *          the module, so this file is an implementation unit of it. The U
+ *          statistic is checked against a pairwise counting reference, which
+ *          shares no code with the rank sums, on samples with many ties.
+ */
+module;
+#include <vct/test_unit_macros.hpp>
+
+module vct.test.unit;
+import std;
+
+namespace {
+    using vct::test::unit::BenchmarkMetric;
+    using vct::test::unit::detail::mann_whitney_p;
+    using vct::test::unit::detail::load_benchmark_baseline;
+
+    /// Two-sided p-value from U counted over all pairs, a tie counting half
+    double reference_p(const std::vector<double>& first, const std::vector<double>& second) {
+        double u = 0;
+        for (const double x : first) {
+            for (const double y : second) u += x > y ? 1.0 : x == y ? 0.5 : 0.0;
+        }
+        std::map<double, double> ties;
+        for (const double x : first) ++ties[x];
+        for (const double y : second) ++ties[y];
+        double tie_sum = 0;
+        for (const auto& [value, count] : ties) tie_sum += count * count * count - count;
+
+        const double a = static_cast<double>(first.size()), b = static_cast<double>(second.size()), n = a + b;
+        const double variance = a * b / 12 * ((n + 1) - tie_sum / (n * (n - 1)));
+        const double z = std::max(std::abs(u - a * b / 2) - 0.5, 0.0) / std::sqrt(variance);
+        return std::erfc(z / std::numbers::sqrt2);
+    }
+
+    std::vector<double> samples(std::mt19937& random, const std::size_t count, const double shift) {
+        std::normal_distribution<double> distribution{ 100 + shift, 1 };
+        std::vector<double> values(count);
+        for (auto& value : values) value = distribution(random);
+        return values;
+    }
+}
+
+M_TEST(MannWhitney, MatchesPairwiseReference) {
+    std::mt19937 random{ 42 };
+    std::uniform_int_distribution<int> value{ 0, 5 };     // Many ties
+    for (std::size_t n1 = 2; n1 <= 20; n1 += 3) {
+        for (std::size_t n2 = 2; n2 <= 20; n2 += 4) {
+            std::vector<double> first(n1), second(n2);
+            for (auto& x : first) x = value(random);
+            for (auto& y : second) y = value(random) + 1;
+            if (std::ranges::all_of(first, [&](const double x) { return x == first[0]; })
+                && std::ranges::all_of(second, [&](const double y) { return y == first[0]; })) {
+                continue;
+            }
+            M_EXPECT_FLOAT_EQ(mann_whitney_p(first, second), reference_p(first, second), 1e-12);
+        }
+    }
+}
+
+M_TEST(MannWhitney, SeparatedSamples) {
+    std::vector<double> low(10), high(10);
+    std::iota(low.begin(), low.end(), 1.0);
+    std::iota(high.begin(), high.end(), 11.0);
+    // U = 0 with n1 = n2 = 10, as given by common statistics packages
+    M_EXPECT_FLOAT_EQ(mann_whitney_p(low, high), 1.826718e-4, 1e-9);
+    M_EXPECT_FLOAT_EQ(mann_whitney_p(high, low), 1.826718e-4, 1e-9);
+}
+
+M_TEST(MannWhitney, NoEvidenceWithoutDifference) {
+    const std::vector<double> values{ 3, 1, 4, 1, 5, 9, 2, 6 };
+    M_EXPECT_EQ(mann_whitney_p(values, values), 1.0);
+    M_EXPECT_EQ(mann_whitney_p(std::vector<double>{ 7, 7, 7 }, std::vector<double>{ 7, 7 }), 1.0);
+    M_EXPECT_EQ(mann_whitney_p({}, values), 1.0);
+    M_EXPECT_EQ(mann_whitney_p(values, {}), 1.0);
+}
+
+M_TEST(MannWhitney, DetectsShiftedDistribution) {
+    std::mt19937 random{ 7 };
+    const auto base = samples(random, 50, 0);
+    const auto same = samples(random, 50, 0);
+    const auto shifted = samples(random, 50, 1);
+    M_EXPECT_GT(mann_whitney_p(base, same), 0.01);
+    M_EXPECT_LT(mann_whitney_p(base, shifted), 0.01);
+
+    // Only the ranks matter
+    auto scaled = shifted;
+    for (auto& x : scaled) x = x * 3 + 1000;
+    auto scaled_base = base;
+    for (auto& x : scaled_base) x = x * 3 + 1000;
+    M_EXPECT_FLOAT_EQ(mann_whitney_p(scaled_base, scaled), mann_whitney_p(base, shifted), 1e-12);
+}
+
+M_TEST(BenchmarkBaseline, LoadsEntriesOfTheMetric) {
+    const auto path = std::filesystem::temp_directory_path() / std::format("vct-baseline-test-{}.txt", std::random_device{}());
+    {
+        std::ofstream file{ path };
+        file << "Sort.Vector time 12.5 12 13 12.5\n"
+             << "Sort.Typed<std::pair<int, int>> time 3 1 2 3\n"
+             << "Sort.Vector instructions 900 900 901\n"
+             << "Sort.NoSamples time 4\n"
+             << "Sort.Vector time 11 11 11\n"
+             << "missing-fields\n"
+             << "Sort.NoMedian time\n"
+             << "\n";
+    }
+    const auto baseline = load_benchmark_baseline(path.string(), BenchmarkMetric::Time);
+    std::filesystem::remove(path);
+
+    M_ASSERT_TRUE(baseline.has_value());
+    M_EXPECT_EQ(baseline->size(), 3u);
+
+    // Later lines override earlier ones
+    M_ASSERT_TRUE(baseline->contains("Sort.Vector"));
+    M_EXPECT_EQ(baseline->at("Sort.Vector").median, 11.0);
+    M_EXPECT_EQ(baseline->at("Sort.Vector").samples.size(), 2u);
+
+    M_ASSERT_TRUE(baseline->contains("Sort.Typed<std::pair<int, int>>"));
+    const auto& typed = baseline->at("Sort.Typed<std::pair<int, int>>");
+    M_EXPECT_EQ(typed.median, 3.0);
+    M_EXPECT_TRUE(typed.samples == std::vector<double>({ 1, 2, 3 }));
+
+    M_ASSERT_TRUE(baseline->contains("Sort.NoSamples"));
+    M_EXPECT_TRUE(baseline->at("Sort.NoSamples").samples.empty());
+
+    M_EXPECT_FALSE(load_benchmark_baseline((path / "missing").string(), BenchmarkMetric::Time).has_value());
+}
@@ -0,0 +1,121 @@
+/**
+ * @file latency_histogram_test.cpp
+ * @brief Tests of the bucket math of LatencyHistogram
+ * @details Buckets are only observable through percentile(), which reports
+ *          the largest value of the bucket holding the percentile. Recording
+ *          a value together with a larger one therefore yields the upper
+ *          bound of the value's bucket, from which the bucket boundaries and
+ *          the relative error are checked over the whole 64-bit range.
+ */
+#include <vct/test_unit_macros.hpp>
+
+import std;
+import vct.test.unit;
+
+namespace {
+    using vct::test::unit::LatencyHistogram;
+
+    constexpr auto largest = std::numeric_limits<std::uint64_t>::max();
+
+    /// Largest value counted in the bucket of `value`, which must be below `largest`
+    std::uint64_t bucket_upper_bound(const std::uint64_t value) {
+        LatencyHistogram histogram;
+        histogram.record(value);
+        histogram.record(largest);
+        return histogram.percentile(50);
+    }
+
+    /// Values around every power of two and a deterministic spread in between
+    std::vector<std::uint64_t> probe_values() {
+        std::vector<std::uint64_t> values;
+        for (unsigned bit = 0; bit < 64; ++bit) {
+            const auto power = std::uint64_t{ 1 } << bit;
+            values.insert(values.end(), { power - 1, power, power + 1 });
+        }
+        std::mt19937_64 random{ 3 };
+        for (int i = 0; i < 1000; ++i) values.push_back(random() >> (random() % 64));
+        std::erase(values, largest);
+        return values;
+    }
+}
+
+M_TEST(LatencyHistogram, SmallValuesAreExact) {
+    for (std::uint64_t value = 0; value < 128; ++value) {
+        M_EXPECT_EQ(bucket_upper_bound(value), value);
+    }
+}
+
+M_TEST(LatencyHistogram, BucketsDoubleInWidthPerPowerOfTwo) {
+    M_EXPECT_EQ(bucket_upper_bound(128), 129u);
+    M_EXPECT_EQ(bucket_upper_bound(255), 255u);
+    M_EXPECT_EQ(bucket_upper_bound(256), 259u);
+    M_EXPECT_EQ(bucket_upper_bound(1000), 1007u);
+    M_EXPECT_EQ(bucket_upper_bound(std::uint64_t{ 1 } << 63), (std::uint64_t{ 1 } << 63) + (std::uint64_t{ 1 } << 57) - 1);
+}
+
+M_TEST(LatencyHistogram, BoundsAreWithinTheRelativeError) {
+    for (const auto value : probe_values()) {
+        const auto bound = bucket_upper_bound(value);
+        M_ASSERT_GE(bound, value);
+        // At most 1/64 above the value, and the bound is the last value of its bucket
+        M_EXPECT_LE((bound - value) * 64, value);
+        M_EXPECT_EQ(bucket_upper_bound(bound), bound);
+        if (bound + 1 < largest) M_EXPECT_GT(bucket_upper_bound(bound + 1), bound);
+    }
+}
+
+M_TEST(LatencyHistogram, CoversTheWholeRange) {
+    LatencyHistogram histogram;
+    histogram.record(largest);
+    histogram.record(0);
+    M_EXPECT_EQ(histogram.percentile(100), largest);
+    M_EXPECT_EQ(histogram.percentile(50), 0u);
+    M_EXPECT_EQ(histogram.min(), 0u);
+    M_EXPECT_EQ(histogram.max(), largest);
+}
+
+M_TEST(LatencyHistogram, PercentilesRankTheValues) {
+    LatencyHistogram histogram;
+    M_EXPECT_EQ(histogram.percentile(50), 0u);
+    M_EXPECT_EQ(histogram.min(), 0u);
+    for (std::uint64_t value = 1000; value >= 1; --value) histogram.record(value);
+    M_EXPECT_EQ(histogram.count(), 1000u);
+    M_EXPECT_EQ(histogram.percentile(0), 1u);
+    M_EXPECT_EQ(histogram.percentile(10), 100u);
+    M_EXPECT_EQ(histogram.percentile(50), 503u);
+    M_EXPECT_EQ(histogram.percentile(99.9), 1000u);
+    M_EXPECT_EQ(histogram.percentile(100), 1000u);
+    M_EXPECT_EQ(histogram.percentile(250), 1000u);
+}
+
+M_TEST(LatencyHistogram, MergeEqualsRecordingEverything) {
+    LatencyHistogram low, high, all;
+    for (std::uint64_t value = 1; value <= 500; ++value) {
+        low.record(value * 3);
+        all.record(value * 3);
+    }
+    for (std::uint64_t value = 1; value <= 300; ++value) {
+        high.record(value * 7919);
+        all.record(value * 7919);
+    }
+    low.merge(high);
+    M_EXPECT_EQ(low.count(), all.count());
+    M_EXPECT_EQ(low.min(), 3u);
+    M_EXPECT_EQ(low.max(), all.max());
+    for (const double percentile : { 1.0, 25.0, 50.0, 90.0, 99.0, 100.0 }) {
+        M_EXPECT_EQ(low.percentile(percentile), all.percentile(percentile));
+    }
+}
+
+M_TEST(LatencyHistogram, CorrectsCoordinatedOmission) {
+    LatencyHistogram histogram;
+    histogram.record(1000, 100);
+    M_EXPECT_EQ(histogram.count(), 10u);
+    M_EXPECT_EQ(histogram.min(), 100u);
+    M_EXPECT_EQ(histogram.max(), 1000u);
+
+    LatencyHistogram fast;
+    fast.record(50, 100);
+    fast.record(70, 0);
+    M_EXPECT_EQ(fast.count(), 2u);
+}
@@ -0,0 +1,12 @@
+/**
+ * @file main.cpp
+ * @brief Entry point of the self-tests
+ * @details The test files register their tests on static initialization,
+ *          either importing the module or, for tests of its internals, as
+ *          implementation units of it.
+ */
+import vct.test.unit;
+
+int main(int argc, char* argv[]) {
+    return vct::test::unit::start(argc, argv);
+}
@@ -0,0 +1,123 @@
+/**
+ * @file parameterized_test.cpp
+ * @brief Tests of value-parameterized tests (M_TEST_P)
+ * @details run_params() and the instance naming are internal to the module,
+ *          so this file is an implementation unit of it. Parameters must be
+ *          pulled one at a time, each instance reported under its index, and
+ *          a failing parameter range reported as a result of its own.
+ */
+module;
+#include <vct/test_unit_macros.hpp>
+
+module vct.test.unit;
+import std;
+
+namespace {
+    using vct::test::unit::TestResult;
+    using vct::test::unit::ParamVisitor;
+    using vct::test::unit::run_params;
+    namespace detail = vct::test::unit::detail;
+
+    /// Parameters pulled from counted_params()
+    std::atomic<int> pulled{ 0 };
+
+    /// Endless parameters counting how many were pulled
+    auto counted_params() {
+        return std::views::iota(0) | std::views::transform([](const int i) { ++pulled; return i; });
+    }
+
+    /// Parameters whose range throws when the third one is pulled
+    auto failing_params() {
+        return std::views::iota(0) | std::views::transform([](const int i) {
+            if (i == 2) throw std::runtime_error{ "parameter source exhausted" };
+            return i;
+        });
+    }
+
+    auto three_params() { return std::views::iota(0, 3); }
+
+    void expect_not_one(const int& param) { M_EXPECT_NE(param, 1); }
+
+    void ignore_param(const int&) {}
+
+    /// Visitor recording the instance indices, stopping after `limit` instances
+    class Recorder final : public ParamVisitor {
+    public:
+        explicit Recorder(const std::size_t limit) : m_limit(limit) {}
+
+        bool visit(const std::size_t index, const std::function<void()>& body) override {
+            indices.push_back(index);
+            body();
+            return indices.size() < m_limit;
+        }
+
+        std::vector<std::size_t> indices;
+
+    private:
+        std::size_t m_limit;
+    };
+
+    /// Run a planned parameterized test, collecting its results and announced instances
+    std::pair<std::vector<TestResult>, std::vector<std::size_t>> run_planned(void (*params)(ParamVisitor&)) {
+        std::vector<TestResult> results;
+        std::vector<std::size_t> announced;
+        const detail::PlannedTest test{ .suite = "S", .name = "P", .params = params };
+        detail::run_test(test, {
+            [&](const std::size_t index) { announced.push_back(index); },
+            [&](TestResult&& result) { results.push_back(std::move(result)); return true; }
+        });
+        return { std::move(results), std::move(announced) };
+    }
+}
+
+M_TEST_P(ParameterizedOptions, Timeout, (std::array{ 1, 2 }), .timeout = std::chrono::seconds{ 7 }) {
+    M_EXPECT_GT(param, 0);
+}
+
+M_TEST(Parameterized, InstancesAreNamedByIndex) {
+    M_EXPECT_EQ(detail::instance_name("Case", 3), "Case/3");
+    M_EXPECT_EQ(detail::instance_name("Case", std::nullopt), "Case");
+
+    TestResult result;
+    result.param_index = 12;
+    M_EXPECT_EQ((vct::test::unit::TestEndEvent{ "Suite", "Case", result, {} }.full_name()), "Case/12");
+}
+
+M_TEST(Parameterized, ParametersArePulledLazily) {
+    pulled = 0;
+    Recorder visitor{ 5 };
+    run_params<&counted_params, &ignore_param>(visitor);
+    M_EXPECT_EQ(visitor.indices.size(), 5u);
+    M_EXPECT_EQ(visitor.indices.back(), 4u);
+    M_EXPECT_EQ(pulled.load(), 5);
+}
+
+M_TEST(Parameterized, ReportsEveryInstance) {
+    const auto [results, announced] = run_planned(&run_params<&three_params, &expect_not_one>);
+    M_ASSERT_EQ(results.size(), 3u);
+    M_EXPECT_TRUE(std::ranges::equal(announced, std::views::iota(0uz, 3uz)));
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        M_EXPECT_TRUE(results[i].param_index == i);
+        M_EXPECT_EQ(results[i].outcome == TestResult::Outcome::Passed, i != 1);
+    }
+}
+
+M_TEST(Parameterized, ReportsFailingParameterRange) {
+    const auto [results, announced] = run_planned(&run_params<&failing_params, &ignore_param>);
+    M_ASSERT_EQ(results.size(), 3u);
+    M_EXPECT_EQ(announced.size(), 2u);
+    const auto& generation = results.back();
+    M_EXPECT_FALSE(generation.param_index.has_value());
+    M_EXPECT_TRUE(generation.outcome == TestResult::Outcome::Unknown);
+    M_ASSERT_EQ(generation.failures.size(), 2u);
+    M_EXPECT_EQ(generation.failures[0].message, "generating the parameters failed");
+    M_EXPECT_EQ(generation.failures[1].message, "parameter source exhausted");
+}
+
+M_TEST(Parameterized, OptionsApplyToTheTest) {
+    const auto& cases = vct::test::unit::get_test_registry()["ParameterizedOptions"];
+    const auto test = std::ranges::find(cases, "Timeout", &vct::test::unit::TestCase::name);
+    M_ASSERT_TRUE(test != cases.end());
+    M_EXPECT_TRUE(test->params != nullptr);
+    M_EXPECT_TRUE(test->options.timeout == std::chrono::seconds{ 7 });
+}
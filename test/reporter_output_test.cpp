@@ -0,0 +1,246 @@
+/**
+ * @file reporter_output_test.cpp
+ * @brief Tests of the streaming JUnit XML and JSON result files
+ * @details Both reporters rewrite their closing tags or brackets after every
+ *          event, so the file must be well-formed after each of them, not
+ *          only at the end of the run. Names and messages use every character
+ *          the formats must escape. Small structural checkers stand in for a
+ *          full parser.
+ */
+#include <vct/test_unit_macros.hpp>
+
+import std;
+import vct.test.unit;
+
+namespace {
+    using namespace vct::test::unit;
+
+    /// Whether an XML entity reference starts at `offset`
+    bool entity_at(const std::string_view text, const std::size_t offset) {
+        constexpr std::array<std::string_view, 5> entities{ "&amp;", "&lt;", "&gt;", "&quot;", "&apos;" };
+        return std::ranges::any_of(entities, [&](const std::string_view entity) {
+            return text.substr(offset).starts_with(entity);
+        });
+    }
+
+    /// Whether `text` is one balanced root element with quoted attributes and escaped text
+    bool well_formed_xml(const std::string_view text) {
+        std::size_t i = 0;
+        if (text.starts_with("<?xml")) {
+            i = text.find("?>");
+            if (i == std::string_view::npos) return false;
+            i += 2;
+        }
+        std::vector<std::string_view> open;
+        bool root_closed = false;
+        while (i < text.size()) {
+            if (text[i] != '<') {
+                const bool space = text[i] == ' ' || text[i] == '\n';
+                if ((open.empty() && !space) || (text[i] == '&' && !entity_at(text, i))) return false;
+                ++i;
+                continue;
+            }
+            std::size_t end = i + 1;
+            for (bool quoted = false; end < text.size() && (quoted || text[end] != '>'); ++end) {
+                if (text[end] == '"') quoted = !quoted;
+                else if (quoted && (text[end] == '<' || (text[end] == '&' && !entity_at(text, end)))) return false;
+            }
+            if (end == text.size()) return false;
+
+            const auto tag = text.substr(i + 1, end - i - 1);
+            const bool closing = tag.starts_with('/');
+            const auto name = tag.substr(closing ? 1 : 0, tag.find_first_of(" />", 1) - (closing ? 1 : 0));
+            if (closing) {
+                if (open.empty() || open.back() != name) return false;
+                open.pop_back();
+                root_closed = open.empty();
+            } else if (!tag.ends_with('/')) {
+                if (root_closed) return false;
+                open.push_back(name);
+            }
+            i = end + 1;
+        }
+        return root_closed && open.empty();
+    }
+
+    /**
+     * @class JsonChecker
+     * @brief Recursive descent recognizer of one JSON value
+     */
+    class JsonChecker {
+    public:
+        static bool check(const std::string_view text) {
+            JsonChecker checker{ text };
+            if (!checker.value()) return false;
+            checker.space();
+            return checker.m_at == text.size();
+        }
+
+    private:
+        explicit JsonChecker(const std::string_view text) : m_text(text) {}
+
+        bool eat(const char c) {
+            space();
+            if (m_at >= m_text.size() || m_text[m_at] != c) return false;
+            ++m_at;
+            return true;
+        }
+
+        void space() {
+            while (m_at < m_text.size() && std::string_view{ " \t\r\n" }.contains(m_text[m_at])) ++m_at;
+        }
+
+        bool value() {
+            space();
+            if (m_at >= m_text.size()) return false;
+            switch (m_text[m_at]) {
+            case '{': return sequence('}', [&] { return string() && eat(':') && value(); });
+            case '[': return sequence(']', [&] { return value(); });
+            case '"': return string();
+            }
+            for (const std::string_view literal : { "true", "false", "null" }) {
+                if (m_text.substr(m_at).starts_with(literal)) {
+                    m_at += literal.size();
+                    return true;
+                }
+            }
+            double number{};
+            const auto [ptr, ec] = std::from_chars(m_text.data() + m_at, m_text.data() + m_text.size(), number);
+            if (ec != std::errc{}) return false;
+            m_at = static_cast<std::size_t>(ptr - m_text.data());
+            return true;
+        }
+
+        bool sequence(const char close, const std::function<bool()>& element) {
+            ++m_at;
+            if (eat(close)) return true;
+            do {
+                if (!element()) return false;
+            } while (eat(','));
+            return eat(close);
+        }
+
+        bool string() {
+            if (!eat('"')) return false;
+            while (m_at < m_text.size() && m_text[m_at] != '"') {
+                if (static_cast<unsigned char>(m_text[m_at]) < 0x20) return false;
+                if (m_text[m_at] == '\\') {
+                    if (++m_at >= m_text.size() || !std::string_view{ "\"\\/bfnrtu" }.contains(m_text[m_at])) return false;
+                }
+                ++m_at;
+            }
+            return eat('"');
+        }
+
+        std::string_view m_text;
+        std::size_t m_at{};
+    };
+
+    /// Characters both formats must escape, and a control character
+    constexpr std::string_view awkward = "<tag attr=\"x\"> & 'y' \\ \t\n\x01";
+
+    std::string read_file(const std::filesystem::path& path) {
+        std::ifstream file{ path, std::ios::binary };
+        return { std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+    }
+
+    /// Unique path in the temporary directory, removed with the object
+    struct TemporaryFile {
+        std::filesystem::path path = std::filesystem::temp_directory_path()
+            / std::format("vct-reporter-test-{}", std::random_device{}());
+        ~TemporaryFile() { std::filesystem::remove(path); }
+    };
+
+    TestResult failed_result() {
+        TestResult result;
+        result.outcome = TestResult::Outcome::Expect;
+        result.failures = { { std::string{ awkward }, "a&b.cpp", 3 }, { "second" } };
+        result.dropped_failures = 2;
+        return result;
+    }
+
+    TestResult error_result() {
+        TestResult result;
+        result.outcome = TestResult::Outcome::Unknown;
+        return result;
+    }
+
+    BenchmarkEndEvent benchmark_event() {
+        BenchmarkEndEvent event;
+        event.suite = "Bench";
+        event.name = "Sort<int, 4>";
+        event.iterations = 1000;
+        event.sample_count = 10;
+        event.mean = event.median = event.min = event.max = 1.5;
+        event.notes = { std::string{ awkward } };
+        return event;
+    }
+
+    /**
+     * @brief Feed a run to a reporter, checking its file after every event
+     * @param complete Whether the suite ends; otherwise the run ends inside it, as after an assertion failure
+     */
+    template<typename Check>
+    bool report_run(Reporter& reporter, const std::filesystem::path& path, const bool complete, Check check) {
+        const std::string suite = std::format("Suite{}", awkward);
+        const std::vector<std::function<void()>> events{
+            [&] { reporter.on_run_start({ 4, 2 }); },
+            [&] { reporter.on_suite_start({ suite, 3 }); },
+            [&] { reporter.on_test_end({ suite, "Passes", {}, std::chrono::milliseconds{ 2 } }); },
+            [&] { reporter.on_test_end({ suite, "Fails<int, \"x\">", failed_result(), {} }); },
+            [&] { reporter.on_test_end({ suite, "Throws", error_result(), {} }); },
+            [&] { if (complete) reporter.on_suite_end({ suite, 3, std::chrono::milliseconds{ 3 } }); },
+            [&] { if (complete) reporter.on_suite_start({ "Bench", 1 }); },
+            [&] { if (complete) reporter.on_benchmark_end(benchmark_event()); },
+            [&] { if (complete) reporter.on_suite_end({ "Bench", 1, {} }); },
+            [&] { reporter.on_run_end({ .test_count = 4, .suite_count = 2, .passed = 2, .failures = { suite + ".Fails" } }); },
+        };
+        for (const auto& event : events) {
+            event();
+            if (!check(read_file(path))) return false;
+        }
+        return true;
+    }
+}
+
+M_TEST(ReporterOutput, XmlIsWellFormedAfterEveryEvent) {
+    for (const bool complete : { true, false }) {
+        const TemporaryFile file;
+        JUnitXmlReporter reporter{ file.path.string() };
+        M_ASSERT_TRUE(reporter.is_open());
+        M_EXPECT_TRUE(report_run(reporter, file.path, complete, well_formed_xml));
+    }
+}
+
+M_TEST(ReporterOutput, XmlCountsFitTheirAttributes) {
+    const TemporaryFile file;
+    JUnitXmlReporter reporter{ file.path.string() };
+    M_ASSERT_TRUE(report_run(reporter, file.path, true, well_formed_xml));
+
+    const auto text = read_file(file.path);
+    M_EXPECT_TRUE(text.contains("<testsuites name=\"AllTests\" tests=\"4\" failures=\"1\" errors=\"1\" time=\""));
+    M_EXPECT_TRUE(text.contains(" tests=\"3\" failures=\"1\" errors=\"1\" time=\"0.003000\""));
+    M_EXPECT_TRUE(text.contains("name=\"Fails&lt;int, &quot;x&quot;&gt;\""));
+    M_EXPECT_TRUE(text.contains("2 more failures not recorded"));
+}
+
+M_TEST(ReporterOutput, JsonIsWellFormedAfterEveryEvent) {
+    for (const bool complete : { true, false }) {
+        const TemporaryFile file;
+        JsonReporter reporter{ file.path.string() };
+        M_ASSERT_TRUE(reporter.is_open());
+        M_EXPECT_TRUE(report_run(reporter, file.path, complete, JsonChecker::check));
+    }
+}
+
+M_TEST(ReporterOutput, CheckersRejectMalformedDocuments) {
+    M_EXPECT_TRUE(well_formed_xml("<?xml version=\"1.0\"?>\n<a x=\"&amp;\"><b/>text</a>\n"));
+    M_EXPECT_FALSE(well_formed_xml("<a><b></a></b>"));
+    M_EXPECT_FALSE(well_formed_xml("<a x=\"<\"></a>"));
+    M_EXPECT_FALSE(well_formed_xml("<a>&</a>"));
+    M_EXPECT_FALSE(well_formed_xml("<a></a>trailing"));
+    M_EXPECT_TRUE(JsonChecker::check("{\"a\": [1, -2.5e3, true, null, \"\\u0001\"], \"b\": {}}"));
+    M_EXPECT_FALSE(JsonChecker::check("{\"a\": [1, 2}"));
+    M_EXPECT_FALSE(JsonChecker::check("[\"\x01\"]"));
+    M_EXPECT_FALSE(JsonChecker::check("[1] ]"));
+}
@@ -0,0 +1,114 @@
+/**
+ * @file result_frame_test.cpp
+ * @brief Tests of the result frames sent from isolated workers to the runner
+ * @details encode_result() and decode_result() are internal to the module,
+ *          so this file is an implementation unit of it. Every field must
+ *          survive the round trip, and truncated or corrupt payloads must be
+ *          rejected rather than read out of bounds.
+ */
+module;
+#include <vct/test_unit_macros.hpp>
+
+module vct.test.unit;
+import std;
+
+#if defined(__unix__) || defined(__APPLE__)
+
+namespace {
+    using vct::test::unit::TestResult;
+    using vct::test::unit::PerfCounter;
+    namespace detail = vct::test::unit::detail;
+
+    /// Index and payload size preceding the payload of a frame
+    constexpr std::size_t header_size = 2 * sizeof(std::uint64_t);
+
+    std::uint64_t read_word(const std::string_view frame, const std::size_t offset) {
+        std::uint64_t value{};
+        std::memcpy(&value, frame.data() + offset, sizeof(value));
+        return value;
+    }
+
+    TestResult sample_result() {
+        TestResult result;
+        result.outcome = TestResult::Outcome::Expect;
+        result.begin = detail::clock::time_point{ detail::clock::duration{ 1'000 } };
+        result.end = detail::clock::time_point{ detail::clock::duration{ 123'456'789 } };
+        result.failures = { { "first", "a.cpp", 12 }, { "", "", 0 }, { std::string(300, 'x'), "b.cpp", 4'000'000'000u } };
+        result.dropped_failures = 7;
+        result.param_index = 42;
+        result.counters = { { PerfCounter::Instructions, 1'000'000 }, { PerfCounter::ContextSwitches, 3 } };
+        return result;
+    }
+}
+
+M_TEST(ResultFrame, RoundTripsEveryField) {
+    const auto result = sample_result();
+    const auto frame = detail::encode_result(5, result);
+    M_ASSERT_GE(frame.size(), header_size);
+    M_EXPECT_EQ(read_word(frame, 0), 5u);
+    M_EXPECT_EQ(read_word(frame, sizeof(std::uint64_t)), frame.size() - header_size);
+
+    const auto decoded = detail::decode_result(std::string_view{ frame }.substr(header_size));
+    M_ASSERT_TRUE(decoded.has_value());
+    M_EXPECT_TRUE(decoded->outcome == result.outcome);
+    M_EXPECT_TRUE(decoded->begin == result.begin);
+    M_EXPECT_TRUE(decoded->end == result.end);
+    M_EXPECT_EQ(decoded->dropped_failures, result.dropped_failures);
+    M_EXPECT_TRUE(decoded->param_index == result.param_index);
+    M_ASSERT_EQ(decoded->failures.size(), result.failures.size());
+    for (std::size_t i = 0; i < result.failures.size(); ++i) {
+        M_EXPECT_EQ(decoded->failures[i].message, result.failures[i].message);
+        M_EXPECT_EQ(decoded->failures[i].file, result.failures[i].file);
+        M_EXPECT_EQ(decoded->failures[i].line, result.failures[i].line);
+    }
+    M_ASSERT_EQ(decoded->counters.size(), result.counters.size());
+    for (std::size_t i = 0; i < result.counters.size(); ++i) {
+        M_EXPECT_TRUE(decoded->counters[i].counter == result.counters[i].counter);
+        M_EXPECT_EQ(decoded->counters[i].value, result.counters[i].value);
+    }
+}
+
+M_TEST(ResultFrame, KeepsMissingParameterIndex) {
+    const std::uint64_t index = detail::suite_tear_down_flag | 3;
+    const auto frame = detail::encode_result(index, TestResult{});
+    M_EXPECT_EQ(read_word(frame, 0), index);
+
+    const auto decoded = detail::decode_result(std::string_view{ frame }.substr(header_size));
+    M_ASSERT_TRUE(decoded.has_value());
+    M_EXPECT_TRUE(decoded->outcome == TestResult::Outcome::Passed);
+    M_EXPECT_FALSE(decoded->param_index.has_value());
+    M_EXPECT_TRUE(decoded->failures.empty());
+    M_EXPECT_TRUE(decoded->counters.empty());
+}
+
+M_TEST(ResultFrame, DoneFrameHasEmptyPayload) {
+    const auto frame = detail::encode_done(9);
+    M_ASSERT_EQ(frame.size(), header_size);
+    M_EXPECT_EQ(read_word(frame, 0), 9u);
+    M_EXPECT_EQ(read_word(frame, sizeof(std::uint64_t)), 0u);
+}
+
+M_TEST(ResultFrame, RejectsTruncatedPayloads) {
+    const auto frame = detail::encode_result(0, sample_result());
+    const auto payload = std::string_view{ frame }.substr(header_size);
+    for (std::size_t size = 0; size < payload.size(); ++size) {
+        M_EXPECT_FALSE(detail::decode_result(payload.substr(0, size)).has_value());
+    }
+}
+
+M_TEST(ResultFrame, RejectsUnknownEnumerators) {
+    const auto frame = detail::encode_result(0, sample_result());
+    auto payload = frame.substr(header_size);
+
+    // The outcome is the first payload byte
+    auto outcome = payload;
+    outcome[0] = static_cast<char>(static_cast<std::uint8_t>(TestResult::Outcome::Timeout) + 1);
+    M_EXPECT_FALSE(detail::decode_result(outcome).has_value());
+
+    // The last counter is followed by its 8-byte value
+    auto counter = payload;
+    counter[counter.size() - sizeof(std::uint64_t) - 1] = static_cast<char>(0xFF);
+    M_EXPECT_FALSE(detail::decode_result(counter).has_value());
+}
+
+#endif
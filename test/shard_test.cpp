@@ -0,0 +1,106 @@
+/**
+ * @file shard_test.cpp
+ * @brief Tests of the assignment of tests to shards
+ * @details select_shard() and load_durations() are internal to the module,
+ *          so this file is an implementation unit of it. The shards must be
+ *          disjoint, cover the plan and keep plan order, and with historical
+ *          durations follow the longest-processing-time-first assignment.
+ */
+module;
+#include <vct/test_unit_macros.hpp>
+
+module vct.test.unit;
+import std;
+
+namespace {
+    using vct::test::unit::detail::PlannedTest;
+    using vct::test::unit::detail::DurationMap;
+    using vct::test::unit::detail::select_shard;
+    using vct::test::unit::detail::load_durations;
+
+    /// A plan of tests named "S.<name>"
+    std::vector<PlannedTest> make_plan(const std::vector<std::string_view>& names) {
+        std::vector<PlannedTest> plan;
+        for (const auto name : names) plan.push_back({ .suite = "S", .name = name });
+        return plan;
+    }
+
+    /// Names of the tests of one shard in shard order, e.g. "A D G"
+    std::string shard_names(
+        const std::vector<PlannedTest>& plan, const std::size_t index, const std::size_t count, const DurationMap& durations
+    ) {
+        std::string names;
+        for (const auto& test : select_shard(plan, index, count, durations)) {
+            names += (names.empty() ? "" : " ") + std::string{ test.name };
+        }
+        return names;
+    }
+}
+
+M_TEST(Shard, RoundRobinWithoutDurations) {
+    const auto plan = make_plan({ "A", "B", "C", "D", "E", "F", "G" });
+    M_EXPECT_EQ(shard_names(plan, 0, 3, {}), "A D G");
+    M_EXPECT_EQ(shard_names(plan, 1, 3, {}), "B E");
+    M_EXPECT_EQ(shard_names(plan, 2, 3, {}), "C F");
+    M_EXPECT_EQ(select_shard(plan, 0, 1, {}).size(), plan.size());
+}
+
+M_TEST(Shard, AssignsLongestFirstToLightestShard) {
+    // A(8) -> 0, B(7) -> 1, C(6) -> 1, D(5) -> 0, E(4) -> 0 on the tie at 13
+    const auto plan = make_plan({ "A", "B", "C", "D", "E" });
+    const DurationMap durations{ { "S.A", 8 }, { "S.B", 7 }, { "S.C", 6 }, { "S.D", 5 }, { "S.E", 4 } };
+    M_EXPECT_EQ(shard_names(plan, 0, 2, durations), "A D E");
+    M_EXPECT_EQ(shard_names(plan, 1, 2, durations), "B C");
+}
+
+M_TEST(Shard, UnknownTestsTakeMedianDuration) {
+    // X counts as 10 and is placed before D, which balances the shards at 20 and 20
+    const auto plan = make_plan({ "A", "B", "C", "D", "X" });
+    const DurationMap durations{ { "S.A", 10 }, { "S.B", 10 }, { "S.C", 10 }, { "S.D", 1 } };
+    M_EXPECT_EQ(shard_names(plan, 0, 2, durations), "A C D");
+    M_EXPECT_EQ(shard_names(plan, 1, 2, durations), "B X");
+}
+
+M_TEST(Shard, ShardsPartitionThePlan) {
+    std::vector<std::string> names;
+    DurationMap durations;
+    for (std::size_t i = 0; i < 50; ++i) {
+        names.push_back(std::format("T{}", i));
+        if (i % 3 != 0) durations.emplace(std::format("S.T{}", i), static_cast<double>(i * 7 % 11));
+    }
+    const auto plan = make_plan({ names.begin(), names.end() });
+
+    for (const auto& history : { DurationMap{}, durations }) {
+        for (std::size_t count = 1; count <= 7; ++count) {
+            std::multiset<std::string_view> seen;
+            for (std::size_t index = 0; index < count; ++index) {
+                const auto shard = select_shard(plan, index, count, history);
+                // Plan order within a shard
+                M_EXPECT_TRUE(std::ranges::is_sorted(shard, {}, [&](const PlannedTest& test) {
+                    return std::ranges::find(plan, test.name, &PlannedTest::name) - plan.begin();
+                }));
+                for (const auto& test : shard) seen.insert(test.name);
+            }
+            M_EXPECT_EQ(seen.size(), plan.size());
+            for (const auto& test : plan) M_EXPECT_EQ(seen.count(test.name), 1u);
+        }
+    }
+}
+
+M_TEST(Shard, LoadsDurationsWithSpacesInNames) {
+    const auto path = std::filesystem::temp_directory_path() / std::format("vct-shard-test-{}.txt", std::random_device{}());
+    {
+        std::ofstream file{ path };
+        file << "Suite.Case<std::pair<int, int>> 1.250\n"
+             << "A.B 2\n"
+             << "A.B\t3\n"
+             << "missing-duration\n"
+             << "\n";
+    }
+    const auto durations = load_durations(path.string());
+    std::filesystem::remove(path);
+
+    M_EXPECT_EQ(durations.size(), 2u);
+    M_EXPECT_TRUE(durations.contains("Suite.Case<std::pair<int, int>>"));
+    M_EXPECT_TRUE(durations.contains("A.B") && durations.at("A.B") == 3.0);
+}
@@ -0,0 +1,152 @@
+/**
+ * @file string_comparison_test.cpp
+ * @brief Tests of the case-insensitive string comparisons against a scalar reference
+ * @details compare_strings() folds and compares 32 (AVX2) or 16 (SSE2) bytes
+ *          per step before finishing the tail byte by byte. These tests put
+ *          a difference at every offset of strings of 0 to 70 bytes, which
+ *          covers every lane of the vector steps and every tail length, and
+ *          use bytes next to the folded range ('@', '[', '`', '{') and
+ *          non-ASCII bytes that only differ in bit 0x20.
+ */
+#include <vct/test_unit_macros.hpp>
+
+import std;
+import vct.test.unit;
+
+namespace {
+    using vct::test::unit::StringComparison;
+    using vct::test::unit::compare_strings;
+
+    constexpr std::size_t max_length = 70;
+
+    /// Strings longer than this are quoted as excerpts around their first difference
+    constexpr std::size_t excerpt_length = 64;
+
+    constexpr char ascii_lower(const char c) noexcept {
+        return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+
+    /// Byte by byte offset of the first difference ignoring ASCII case, over the shorter length
+    std::size_t reference_mismatch(const std::string_view s1, const std::string_view s2) noexcept {
+        const auto length = std::min(s1.size(), s2.size());
+        std::size_t i = 0;
+        while (i < length && ascii_lower(s1[i]) == ascii_lower(s2[i])) ++i;
+        return i;
+    }
+
+    /// Mixed-case letters, so that every lane also folds matching bytes
+    std::string mixed_case(const std::size_t length) {
+        std::string text(length, '\0');
+        for (std::size_t i = 0; i < length; ++i) {
+            const auto letter = static_cast<char>('a' + i % 26);
+            text[i] = i % 3 == 0 ? static_cast<char>(letter - 'a' + 'A') : letter;
+        }
+        return text;
+    }
+
+    /// The same letters with their case swapped
+    std::string swapped_case(std::string text) {
+        for (auto& c : text) {
+            if (c >= 'a' && c <= 'z') c = static_cast<char>(c - 'a' + 'A');
+            else if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+        }
+        return text;
+    }
+
+    /// Byte pairs placed at the tested offset, equal or not when ASCII case is ignored
+    constexpr std::array<std::pair<char, char>, 14> byte_pairs{ {
+        { 'a', 'b' },
+        { 'A', 'a' },
+        { 'Z', 'z' },
+        { '@', '`' },                                               // Below 'A' and 'a', 0x20 apart
+        { '[', '{' },                                               // Above 'Z' and 'z', 0x20 apart
+        { 'Z', '[' },
+        { '@', 'A' },
+        { 'z', '{' },
+        { '@', '@' },
+        { '\0', ' ' },
+        { static_cast<char>(0xC1), static_cast<char>(0xE1) },      // Non-ASCII, 0x20 apart
+        { static_cast<char>(0x80), static_cast<char>(0xA0) },
+        { static_cast<char>(0xDF), static_cast<char>(0xFF) },
+        { static_cast<char>(0xC1), static_cast<char>(0xC1) },
+    } };
+}
+
+M_TEST(StringComparison, IgnoringCaseMatchesScalarReference) {
+    for (std::size_t length = 0; length <= max_length; ++length) {
+        const auto s1 = mixed_case(length);
+        const auto s2 = swapped_case(s1);
+        M_EXPECT_FALSE(compare_strings(s1, s2, StringComparison::EqualIgnoringCase, "s1", "s2").has_value());
+
+        for (std::size_t offset = 0; offset < length; ++offset) {
+            for (const auto& [b1, b2] : byte_pairs) {
+                auto a = s1;
+                auto b = s2;
+                a[offset] = b1;
+                b[offset] = b2;
+                const bool equal = reference_mismatch(a, b) == length;
+                const auto failure = compare_strings(a, b, StringComparison::EqualIgnoringCase, "a", "b");
+                M_EXPECT_EQ(failure.has_value(), !equal);
+                M_EXPECT_EQ(compare_strings(a, b, StringComparison::NotEqualIgnoringCase, "a", "b").has_value(), equal);
+            }
+        }
+    }
+}
+
+M_TEST(StringComparison, IgnoringCaseReportsFirstDifference) {
+    // The longer second string is quoted as an excerpt, while the offset is
+    // computed over the length of the first one
+    const auto padding = std::string(excerpt_length + 1, '-');
+    for (std::size_t length = 0; length <= max_length; ++length) {
+        const auto s1 = mixed_case(length);
+        const auto s2 = swapped_case(s1);
+
+        for (std::size_t offset = 0; offset <= length; ++offset) {
+            for (const auto& [b1, b2] : byte_pairs) {
+                auto a = s1;
+                auto b = s2;
+                if (offset < length) {
+                    a[offset] = b1;
+                    b[offset] = b2;
+                }
+                b += padding;
+                const auto failure = compare_strings(a, b, StringComparison::EqualIgnoringCase, "a", "b");
+                M_ASSERT_TRUE(failure.has_value());
+                const auto expected = std::format("First difference at offset {} (sizes {} and {})", reference_mismatch(a, b), a.size(), b.size());
+                M_EXPECT_TRUE(failure->contains(expected));
+            }
+        }
+    }
+}
+
+M_TEST(StringComparison, CaseSensitiveMatchesScalarReference) {
+    const auto padding = std::string(excerpt_length + 1, '-');
+    for (std::size_t length = 0; length <= max_length; ++length) {
+        const auto s1 = mixed_case(length);
+        for (std::size_t offset = 0; offset < length; ++offset) {
+            auto a = s1;
+            a[offset] = static_cast<char>(a[offset] ^ 0x20);
+            M_EXPECT_TRUE(compare_strings(s1, a, StringComparison::Equal, "s1", "a").has_value());
+            M_EXPECT_FALSE(compare_strings(s1, a, StringComparison::EqualIgnoringCase, "s1", "a").has_value());
+
+            const auto failure = compare_strings(s1, a + padding, StringComparison::Equal, "s1", "a");
+            M_ASSERT_TRUE(failure.has_value());
+            M_EXPECT_TRUE(failure->contains(std::format("First difference at offset {} (sizes", offset)));
+        }
+    }
+}
+
+M_TEST(StringComparison, ShortStringsReportFirstDifference) {
+    const auto failure = compare_strings("abcd", "abXd", StringComparison::Equal, "s1", "s2");
+    M_ASSERT_TRUE(failure.has_value());
+    M_EXPECT_TRUE(failure->contains("First difference at offset 2 (sizes 4 and 4)"));
+
+    const auto prefix = compare_strings("abc", "ab", StringComparison::EqualIgnoringCase, "s1", "s2");
+    M_ASSERT_TRUE(prefix.has_value());
+    M_EXPECT_TRUE(prefix->contains("First difference at offset 2 (sizes 3 and 2)"));
+
+    // Expected differences have no offset to report
+    const auto equal = compare_strings("abc", "abc", StringComparison::NotEqual, "s1", "s2");
+    M_ASSERT_TRUE(equal.has_value());
+    M_EXPECT_FALSE(equal->contains("First difference"));
+}
@@ -0,0 +1,163 @@
+/**
+ * @file suite_fixtures_test.cpp
+ * @brief Tests of the once-per-suite fixture hooks
+ * @details SuiteFixtures is internal to the module, so this file is an
+ *          implementation unit of it. Plans are built by hand from functions
+ *          that record the order of the hooks and test bodies; each test
+ *          uses its own recorder, so the tests may run in parallel.
+ */
+module;
+#include <vct/test_unit_macros.hpp>
+
+module vct.test.unit;
+import std;
+
+namespace {
+    using vct::test::unit::TestResult;
+    using vct::test::unit::SuiteHooks;
+    using vct::test::unit::detail::PlannedTest;
+    using vct::test::unit::detail::SuiteFixtures;
+    using vct::test::unit::detail::ResultSink;
+
+    /// Hooks and test bodies appending to a log of their own
+    template<int Id>
+    struct Recorder {
+        static inline std::mutex mutex;
+        static inline std::vector<std::string> log;
+
+        static void record(std::string entry) {
+            std::lock_guard lock{ mutex };
+            log.push_back(std::move(entry));
+        }
+
+        static std::string joined() {
+            std::lock_guard lock{ mutex };
+            std::string text;
+            for (const auto& entry : log) text += (text.empty() ? "" : " ") + entry;
+            return text;
+        }
+
+        static std::size_t count(const std::string_view entry) {
+            std::lock_guard lock{ mutex };
+            return static_cast<std::size_t>(std::ranges::count(log, entry));
+        }
+
+        static void set_up() { record("set-up"); }
+        static void tear_down() { record("tear-down"); }
+        static void failing_set_up() { record("set-up"); throw std::runtime_error{ "no database" }; }
+        static void failing_tear_down() { record("tear-down"); throw std::runtime_error{ "leaked handle" }; }
+
+        template<char Name>
+        static void body() { record(std::string{ Name }); }
+
+        static constexpr SuiteHooks hooks{ &set_up, &tear_down };
+    };
+
+    /// Run plan[index] and return its only result
+    TestResult run_one(SuiteFixtures& fixtures, const std::size_t index) {
+        TestResult out;
+        fixtures.run(index, { {}, [&](TestResult&& result) { out = std::move(result); return true; } });
+        return out;
+    }
+
+    bool mentions(const TestResult& result, const std::string_view text) {
+        return std::ranges::any_of(result.failures, [&](const auto& failure) { return failure.message.contains(text); });
+    }
+}
+
+M_TEST(SuiteFixtures, HooksRunOnceAroundTheSuite) {
+    using R = Recorder<0>;
+    const std::vector<PlannedTest> plan{
+        { .suite = "A", .name = "a", .func = &R::body<'a'>, .hooks = R::hooks },
+        { .suite = "A", .name = "b", .func = &R::body<'b'>, .hooks = R::hooks },
+        { .suite = "B", .name = "c", .func = &R::body<'c'> },
+    };
+    SuiteFixtures fixtures{ plan };
+    for (std::size_t i = 0; i < plan.size(); ++i) {
+        M_EXPECT_TRUE(run_one(fixtures, i).outcome == TestResult::Outcome::Passed);
+    }
+    M_EXPECT_EQ(R::joined(), "set-up a b tear-down c");
+}
+
+M_TEST(SuiteFixtures, ParallelTestsShareOneSetUp) {
+    using R = Recorder<1>;
+    constexpr std::size_t tests = 64;
+    const std::vector<PlannedTest> plan(tests, { .suite = "A", .name = "a", .func = &R::body<'a'>, .hooks = R::hooks });
+    SuiteFixtures fixtures{ plan };
+    {
+        vct::test::unit::detail::WorkStealingPool pool{ 8, tests };
+        pool.launch([&](const std::size_t index) { run_one(fixtures, index); }, [] {});
+    }
+    M_EXPECT_EQ(R::count("set-up"), 1u);
+    M_EXPECT_EQ(R::count("a"), tests);
+    M_EXPECT_EQ(R::count("tear-down"), 1u);
+    M_EXPECT_TRUE(R::joined().starts_with("set-up a"));
+    M_EXPECT_TRUE(R::joined().ends_with("a tear-down"));
+}
+
+M_TEST(SuiteFixtures, FailingSetUpFailsEveryTest) {
+    using R = Recorder<2>;
+    const SuiteHooks hooks{ &R::failing_set_up, &R::tear_down };
+    const std::vector<PlannedTest> plan{
+        { .suite = "A", .name = "a", .func = &R::body<'a'>, .hooks = hooks },
+        { .suite = "A", .name = "b", .func = &R::body<'b'>, .hooks = hooks },
+    };
+    SuiteFixtures fixtures{ plan };
+    for (std::size_t i = 0; i < plan.size(); ++i) {
+        const auto result = run_one(fixtures, i);
+        M_EXPECT_TRUE(result.outcome != TestResult::Outcome::Passed);
+        M_EXPECT_TRUE(mentions(result, "no database"));
+    }
+    M_EXPECT_EQ(R::count("set-up"), 1u);
+    M_EXPECT_EQ(R::count("a") + R::count("b"), 0u);
+}
+
+M_TEST(SuiteFixtures, FailingTearDownFailsTheLastTest) {
+    using R = Recorder<3>;
+    const SuiteHooks hooks{ &R::set_up, &R::failing_tear_down };
+    const std::vector<PlannedTest> plan{
+        { .suite = "A", .name = "a", .func = &R::body<'a'>, .hooks = hooks },
+        { .suite = "A", .name = "b", .func = &R::body<'b'>, .hooks = hooks },
+    };
+    SuiteFixtures fixtures{ plan };
+    M_EXPECT_TRUE(run_one(fixtures, 0).outcome == TestResult::Outcome::Passed);
+    const auto last = run_one(fixtures, 1);
+    M_EXPECT_TRUE(last.outcome == TestResult::Outcome::Unknown);
+    M_EXPECT_TRUE(mentions(last, "TearDownTestSuite() of A failed"));
+    M_EXPECT_TRUE(mentions(last, "leaked handle"));
+}
+
+M_TEST(SuiteFixtures, UnfinishedSuitesAreTornDownOnDestruction) {
+    using R = Recorder<4>;
+    const std::vector<PlannedTest> plan{
+        { .suite = "A", .name = "a", .func = &R::body<'a'>, .hooks = R::hooks },
+        { .suite = "A", .name = "b", .func = &R::body<'b'>, .hooks = R::hooks },
+    };
+    {
+        SuiteFixtures fixtures{ plan };
+        run_one(fixtures, 0);
+        M_EXPECT_EQ(R::joined(), "set-up a");
+    }
+    M_EXPECT_EQ(R::joined(), "set-up a tear-down");
+}
+
+M_TEST(SuiteFixtures, TestTearDownRunsAfterFailingBody) {
+    class Fixture final : public vct::test::unit::Test {
+    public:
+        std::vector<std::string_view> calls;
+
+    protected:
+        void SetUp() override { calls.push_back("SetUp"); }
+        void TearDown() override { calls.push_back("TearDown"); }
+
+    private:
+        void TestBody() override {
+            calls.push_back("TestBody");
+            throw std::runtime_error{ "body failed" };
+        }
+    } fixture;
+
+    M_EXPECT_THROW(fixture.run(), std::runtime_error);
+    M_EXPECT_EQ(fixture.calls.size(), 3u);
+    M_EXPECT_TRUE(std::ranges::equal(fixture.calls, std::array<std::string_view, 3>{ "SetUp", "TestBody", "TearDown" }));
+}
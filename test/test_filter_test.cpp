@@ -0,0 +1,88 @@
+/**
+ * @file test_filter_test.cpp
+ * @brief Tests of the precompiled test filter against a regex reference
+ * @details TestFilter is internal to the module, so this file is an
+ *          implementation unit of it. The filter classifies patterns into
+ *          exact, prefix, suffix and general globs; every pattern of up to 4
+ *          characters over "ab*?" is checked against std::regex on every
+ *          name of up to 5 characters over "ab", which covers each class
+ *          and the backtracking of the general glob.
+ */
+module;
+#include <vct/test_unit_macros.hpp>
+
+module vct.test.unit;
+import std;
+
+namespace {
+    using vct::test::unit::detail::TestFilter;
+
+    /// Every string of up to `max_length` characters over `alphabet`
+    std::vector<std::string> all_strings(const std::string_view alphabet, const std::size_t max_length) {
+        std::vector<std::string> strings{ "" };
+        for (std::size_t begin = 0, length = 1; length <= max_length; ++length) {
+            const std::size_t end = strings.size();
+            for (std::size_t i = begin; i < end; ++i) {
+                for (const char c : alphabet) strings.push_back(strings[i] + c);
+            }
+            begin = end;
+        }
+        return strings;
+    }
+
+    /// The glob as an ECMAScript regex, for patterns over "ab*?"
+    std::regex reference_glob(const std::string_view pattern) {
+        std::string regex;
+        for (const char c : pattern) {
+            regex += c == '*' ? std::string{ ".*" } : c == '?' ? std::string{ "." } : std::string{ c };
+        }
+        return std::regex{ regex };
+    }
+}
+
+M_TEST(TestFilter, GlobsMatchRegexReference) {
+    const auto names = all_strings("ab", 5);
+    for (const auto& pattern : all_strings("ab*?", 4)) {
+        if (pattern.empty()) continue;
+        const TestFilter filter{ pattern };
+        const auto regex = reference_glob(pattern);
+        for (const auto& name : names) {
+            M_EXPECT_EQ(filter.matches(name), std::regex_match(name, regex));
+        }
+    }
+}
+
+M_TEST(TestFilter, NegativePatternsExclude) {
+    const TestFilter filter{ "Math.*:Io.Read*-Math.Slow*:*.Huge" };
+    M_EXPECT_TRUE(filter.matches("Math.Add"));
+    M_EXPECT_TRUE(filter.matches("Io.ReadAll"));
+    M_EXPECT_FALSE(filter.matches("Io.Write"));
+    M_EXPECT_FALSE(filter.matches("Math.SlowAdd"));
+    M_EXPECT_FALSE(filter.matches("Math.Huge"));
+
+    // Without positive patterns, everything not excluded is selected
+    const TestFilter negative{ "-Math.*" };
+    M_EXPECT_FALSE(negative.matches_all());
+    M_EXPECT_TRUE(negative.matches("Io.Write"));
+    M_EXPECT_FALSE(negative.matches("Math.Add"));
+}
+
+M_TEST(TestFilter, DoubleColonsDoNotSeparatePatterns) {
+    const TestFilter filter{ "Suite.Case<std::string>:Other.*-*<std::pair<int, int>>" };
+    M_EXPECT_TRUE(filter.matches("Suite.Case<std::string>"));
+    M_EXPECT_TRUE(filter.matches("Other.Case"));
+    M_EXPECT_FALSE(filter.matches("Suite.Case<int>"));
+    M_EXPECT_FALSE(filter.matches("std::string>"));
+    M_EXPECT_FALSE(filter.matches("Other.Case<std::pair<int, int>>"));
+    M_EXPECT_TRUE(filter.matches("Other.Case<std::pair<int, long>>"));
+}
+
+M_TEST(TestFilter, SelectsAllWithoutPatterns) {
+    for (const std::string_view expression : { "", "*", ":", "*:Suite.Case", "*-" }) {
+        const TestFilter filter{ expression };
+        M_EXPECT_TRUE(filter.matches_all());
+        M_EXPECT_TRUE(filter.matches("Any.Test"));
+    }
+    M_EXPECT_TRUE(TestFilter{}.matches_all());
+    M_EXPECT_FALSE(TestFilter{ "Suite.*" }.matches_all());
+}
@@ -0,0 +1,62 @@
+/**
+ * @file type_name_test.cpp
+ * @brief Tests of the compile-time type names of typed tests
+ * @details raw_type_name() and strip_type_name() are internal to the module,
+ *          so this file is an implementation unit of it. Spellings of class
+ *          types differ between compilers, so the stripping is tested on
+ *          fixed strings and the compiler spelling on fundamental types.
+ */
+module;
+#include <vct/test_unit_macros.hpp>
+
+module vct.test.unit;
+import std;
+
+namespace {
+    using vct::test::unit::type_name;
+    namespace detail = vct::test::unit::detail;
+
+    /// strip_type_name() into a string, sized by a first counting pass
+    std::string strip(const std::string_view text) {
+        std::string out(detail::strip_type_name(text, nullptr), '\0');
+        detail::strip_type_name(text, out.data());
+        return out;
+    }
+}
+
+M_TYPED_TEST(TypedNaming, Instances, vct::test::unit::Types<int, char, double>) {
+    M_EXPECT_GT(sizeof(TypeParam), 0u);
+}
+
+M_TEST(TypeName, CompilerSpellsFundamentalTypes) {
+    M_EXPECT_EQ(detail::raw_type_name<int>(), "int");
+    M_EXPECT_EQ(detail::raw_type_name<double>(), "double");
+    M_EXPECT_EQ(detail::raw_type_name<unsigned int>(), "unsigned int");
+    M_EXPECT_EQ(type_name<char>(), "char");
+}
+
+M_TEST(TypeName, StripsInlineNamespaces) {
+    M_EXPECT_EQ(strip("std::__cxx11::basic_string<char>"), "std::basic_string<char>");
+    M_EXPECT_EQ(strip("std::__1::vector<std::__1::pair<int, int>>"), "std::vector<std::pair<int, int>>");
+    M_EXPECT_EQ(strip("__cxx11::list<int>"), "list<int>");
+    M_EXPECT_EQ(strip(""), "");
+}
+
+M_TEST(TypeName, KeepsNoiseInsideIdentifiers) {
+    M_EXPECT_EQ(strip("my__cxx11::type"), "my__cxx11::type");
+    M_EXPECT_EQ(strip("ns::v__1::type<a__1::b>"), "ns::v__1::type<a__1::b>");
+}
+
+M_TEST(TypeName, StandardTypesHaveNoInlineNamespace) {
+    const auto name = type_name<std::string>();
+    M_EXPECT_TRUE(name.starts_with("std::basic_string<char"));
+    M_EXPECT_FALSE(name.contains("__cxx11"));
+    M_EXPECT_FALSE(name.contains("__1::"));
+}
+
+M_TEST(TypeName, TypedTestsAreNamedAfterTheirTypes) {
+    const auto& cases = vct::test::unit::get_test_registry()["TypedNaming"];
+    std::string names;
+    for (const auto& test : cases) names += (names.empty() ? "" : " ") + test.name;
+    M_EXPECT_EQ(names, "Instances<int> Instances<char> Instances<double>");
+}
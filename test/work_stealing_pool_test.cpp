@@ -0,0 +1,76 @@
+/**
+ * @file work_stealing_pool_test.cpp
+ * @brief Tests of the thread pool of the parallel runner
+ * @details WorkStealingPool is internal to the module, so this file is an
+ *          implementation unit of it. Each task index must run exactly once
+ *          for any split of the tasks, and a worker blocked on a slow task
+ *          must not hold back the rest of its block.
+ */
+module;
+#include <vct/test_unit_macros.hpp>
+
+module vct.test.unit;
+import std;
+
+namespace {
+    using vct::test::unit::detail::WorkStealingPool;
+
+    /// How long a test waits for tasks that only stealing can run
+    constexpr auto steal_timeout = std::chrono::seconds{ 10 };
+}
+
+M_TEST(WorkStealingPool, RunsEveryTaskOnce) {
+    for (std::size_t workers = 1; workers <= 8; ++workers) {
+        for (const std::size_t tasks : { 0uz, 1uz, 7uz, 8uz, 100uz }) {
+            std::vector<std::atomic<int>> runs(tasks);
+            std::atomic<std::size_t> exits{ 0 };
+            {
+                WorkStealingPool pool{ workers, tasks };
+                M_EXPECT_EQ(pool.size(), workers);
+                pool.launch(
+                    [&](const std::size_t index) { runs[index].fetch_add(1, std::memory_order_relaxed); },
+                    [&] { exits.fetch_add(1, std::memory_order_relaxed); }
+                );
+            }
+            M_EXPECT_EQ(exits.load(), workers);
+            M_EXPECT_TRUE(std::ranges::all_of(runs, [](const auto& count) { return count.load() == 1; }));
+        }
+    }
+}
+
+M_TEST(WorkStealingPool, IdleWorkersStealFromBusyOnes) {
+    // Worker 0 owns tasks 0 to 4 and blocks in task 0 until all others ran,
+    // so tasks 1 to 4 complete only if worker 1 steals them
+    constexpr std::size_t tasks = 10;
+    std::mutex mutex;
+    std::condition_variable done;
+    std::size_t finished = 0;
+    bool stolen = false;
+    {
+        WorkStealingPool pool{ 2, tasks };
+        pool.launch(
+            [&](const std::size_t index) {
+                std::unique_lock lock{ mutex };
+                if (index == 0) {
+                    stolen = done.wait_for(lock, steal_timeout, [&] { return finished == tasks - 1; });
+                } else {
+                    ++finished;
+                    done.notify_all();
+                }
+            },
+            [] {}
+        );
+    }
+    M_EXPECT_TRUE(stolen);
+}
+
+M_TEST(WorkStealingPool, StopsPickingUpTasks) {
+    constexpr std::size_t tasks = 1000;
+    std::atomic<std::size_t> runs{ 0 };
+    {
+        WorkStealingPool pool{ 4, tasks };
+        pool.request_stop();
+        pool.launch([&](std::size_t) { runs.fetch_add(1, std::memory_order_relaxed); }, [] {});
+    }
+    M_EXPECT_EQ(runs.load(), 0);
+}